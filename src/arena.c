@@ -0,0 +1,91 @@
+/* Arena allocator for a game session's memory */
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+/* FUNCTIONS */
+void init_arena(arena *session_arena);
+void *arena_alloc(arena *session_arena, size_t size);
+void reset_arena(arena *session_arena);
+void free_arena(arena *session_arena);
+
+// Initialize an empty arena
+void init_arena(arena *session_arena)
+{
+    memset(session_arena, 0, sizeof(arena));
+}
+
+// Allocate memory from arena -> valid until the arena is reset
+// Returns NULL if out of memory
+void *arena_alloc(arena *session_arena, size_t size)
+{
+    size = (size + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1);
+
+    // Current block is full -> move on to the next block, malloc one only if there's none left
+    arena_block *block = session_arena -> current;
+
+    while (block == NULL || block -> used + size > block -> size)
+    {
+        arena_block *next = (block == NULL) ? session_arena -> blocks : block -> next;
+
+        if (next == NULL)
+        {
+            size_t block_size = (size > ARENA_BLOCK) ? size : ARENA_BLOCK;
+
+            next = (arena_block *) malloc(sizeof(arena_block) + block_size);
+            if (next == NULL)
+            {
+                return NULL;
+            }
+
+            next -> next = NULL;
+            next -> size = block_size;
+
+            if (block == NULL)
+            {
+                session_arena -> blocks = next;
+            }
+            else
+            {
+                block -> next = next;
+            }
+
+            session_arena -> system_allocations++;
+        }
+
+        next -> used = 0;
+        block = next;
+    }
+
+    session_arena -> current = block;
+
+    void *memory = (char *) block -> data + block -> used;
+    block -> used += size;
+
+    session_arena -> allocations++;
+    session_arena -> bytes += size;
+
+    return memory;
+}
+
+// Release everything allocated from arena -> blocks are kept for reuse
+void reset_arena(arena *session_arena)
+{
+    session_arena -> current = NULL;
+}
+
+// Give arena's blocks back to the system
+void free_arena(arena *session_arena)
+{
+    arena_block *block = session_arena -> blocks;
+
+    while (block != NULL)
+    {
+        arena_block *next = block -> next;
+        free(block);
+        block = next;
+    }
+
+    session_arena -> blocks = session_arena -> current = NULL;
+}
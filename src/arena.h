@@ -0,0 +1,36 @@
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include <stddef.h>
+
+/* DEFINITIONS */
+#define ARENA_BLOCK 4096                // Bytes of a block, bigger allocations get a block of their own
+#define ARENA_ALIGN 16
+
+/* Block of memory an arena hands out -> chained, kept for reuse after a reset */
+typedef struct arena_block
+{
+    struct arena_block *next;
+    size_t size;
+    size_t used;
+    max_align_t data[];
+}arena_block;
+
+/* Arena -> bump allocator, everything is released at once */
+typedef struct arena
+{
+    arena_block *blocks;                // First block
+    arena_block *current;               // Block allocated from, NULL -> nothing allocated since reset
+
+    long allocations;                   // Calls to arena_alloc
+    long bytes;                         // Bytes handed out
+    long system_allocations;            // Blocks taken from malloc
+}arena;
+
+/* FUNCTIONS */
+void init_arena(arena *session_arena);
+void *arena_alloc(arena *session_arena, size_t size);
+void reset_arena(arena *session_arena);
+void free_arena(arena *session_arena);
+
+#endif
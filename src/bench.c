@@ -0,0 +1,200 @@
+/* Headless engine vs engine benchmark */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "book.h"
+#include "engine.h"
+#include "position.h"
+#include "tablebase.h"
+#include "tools.h"
+
+/* DEFINITIONS */
+#define DEFAULT_GAMES   1000000
+#define DEFAULT_SEED    1
+
+#define LATENCY_SAMPLE  64              // Time one of every 64 moves
+#define BUCKET_NS       10              // Latency histogram resolution
+#define NO_BUCKETS      100000          // Up to 1 ms, slower moves share the last bucket
+
+#define NO_PERCENTILES  5
+
+/* Benchmark results */
+typedef struct results
+{
+    long games;
+    long moves;
+    long first_player_wins;
+    double seconds;
+
+    long samples;
+    long max_latency;
+    long *latency_counts;               // Histogram of sampled move latencies
+}results;
+
+/* FUNCTIONS */
+void run_games(engine *eng, long no_games, results *res);
+long latency_percentile(results *res, double percentile);
+void print_results(results *res);
+
+int main(int argc, char *argv[])
+{
+    long no_games = DEFAULT_GAMES;
+    uint64_t seed = DEFAULT_SEED;
+    char *tablebase_file = NULL;
+    char *book_file = NULL;
+
+    // Read options
+    char *value;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((value = option_value(argc, argv, &i, "-g", "--games")) != NULL)
+        {
+            no_games = strtol(value, NULL, 10);
+        }
+        else if ((value = option_value(argc, argv, &i, "-s", "--seed")) != NULL)
+        {
+            seed = strtoull(value, NULL, 10);
+        }
+        else if ((value = option_value(argc, argv, &i, "-t", "--tablebase")) != NULL)
+        {
+            tablebase_file = value;
+        }
+        else if ((value = option_value(argc, argv, &i, "-b", "--book")) != NULL)
+        {
+            book_file = value;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-g | --games <number>] [-s | --seed <number>] [-t | --tablebase <file>] [-b | --book <file>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Play games
+    engine eng;
+    init_engine(&eng, seed);
+
+    if (tablebase_file != NULL && !load_tablebase(&eng, tablebase_file))
+    {
+        fprintf(stderr, "bench: couldn't load tablebase %s\n", tablebase_file);
+        return 1;
+    }
+
+    if (book_file != NULL && !load_book(&eng, book_file))
+    {
+        fprintf(stderr, "bench: couldn't load book %s\n", book_file);
+        return 1;
+    }
+
+    results res;
+    memset(&res, 0, sizeof(results));
+    res.latency_counts = (long *) calloc(NO_BUCKETS, sizeof(long));
+
+    if (res.latency_counts == NULL)
+    {
+        fprintf(stderr, "bench: out of memory\n");
+        return 1;
+    }
+
+    run_games(&eng, no_games, &res);
+    print_results(&res);
+
+    free(res.latency_counts);
+    unload_tablebase(&eng);
+    unload_book(&eng);
+
+    return 0;
+}
+
+// Play engine vs engine games & collect results
+void run_games(engine *eng, long no_games, results *res)
+{
+    int dead_boards[NO_BOARDS];
+    long start = now_ns();
+
+    for (long i = 0; i < no_games; i++)
+    {
+        position pos = 0;
+        int turn = 1;
+
+        while (!is_finished(pos, dead_boards))
+        {
+            int move;
+
+            // Sample latency of some moves only -> keeps timing out of throughput
+            if (!(res -> moves % LATENCY_SAMPLE))
+            {
+                long before = now_ns();
+                move = choose_move(eng, pos);
+                long latency = now_ns() - before;
+
+                int bucket = latency / BUCKET_NS;
+                res -> latency_counts[(bucket < NO_BUCKETS) ? bucket : NO_BUCKETS - 1]++;
+                res -> max_latency = (latency > res -> max_latency) ? latency : res -> max_latency;
+                res -> samples++;
+            }
+            else
+            {
+                move = choose_move(eng, pos);
+            }
+
+            pos |= MOVE_BIT(move);
+            res -> moves++;
+            turn *= -1;
+        }
+
+        // Player to move after the last board died wins
+        if (turn == 1)
+        {
+            res -> first_player_wins++;
+        }
+
+        res -> games++;
+    }
+
+    res -> seconds = (now_ns() - start) / 1e9;
+}
+
+// Find a latency percentile from the histogram
+// Returns upper bound of the bucket the percentile falls in (ns)
+long latency_percentile(results *res, double percentile)
+{
+    long target = res -> samples * percentile / 100.0;
+    long counter = 0;
+
+    for (int i = 0; i < NO_BUCKETS; i++)
+    {
+        counter += res -> latency_counts[i];
+
+        if (counter > target)
+        {
+            return (i == NO_BUCKETS - 1) ? res -> max_latency : (i + 1) * BUCKET_NS;
+        }
+    }
+
+    return res -> max_latency;
+}
+
+// Print benchmark results
+void print_results(results *res)
+{
+    const double percentiles[NO_PERCENTILES] = {50, 90, 99, 99.9, 99.99};
+
+    double seconds = (res -> seconds > 0) ? res -> seconds : 1e-9;
+
+    printf("games             : %ld\n", res -> games);
+    printf("moves             : %ld\n", res -> moves);
+    printf("time              : %.3f s\n", res -> seconds);
+    printf("games/sec         : %.0f\n", res -> games / seconds);
+    printf("moves/sec         : %.0f\n", res -> moves / seconds);
+    printf("first player wins : %.2f%%\n", res -> games ? (res -> first_player_wins * 100.0) / res -> games : 0);
+
+    printf("move latency      : %ld samples\n", res -> samples);
+    for (int i = 0; i < NO_PERCENTILES; i++)
+    {
+        printf("    p%-6g       : %ld ns\n", percentiles[i], latency_percentile(res, percentiles[i]));
+    }
+    printf("    max           : %ld ns\n", res -> max_latency);
+}
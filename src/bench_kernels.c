@@ -0,0 +1,249 @@
+/* Engine kernels micro-benchmark -> results printed as JSON */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "engine.h"
+#include "position.h"
+#include "symmetry.h"
+#include "tools.h"
+
+/* DEFINITIONS */
+#define DEFAULT_ROUNDS  20000
+#define DEFAULT_SEED    1
+
+#define NO_CONFIGS      512
+#define NO_POSITIONS    512             // Random positions per round
+
+#define NO_KERNELS      9
+
+/* Kernel to benchmark */
+typedef struct kernel
+{
+    char *name;
+    char *inputs;                       // "boards": all board masks, "positions": random positions
+    long (*run)(long rounds);           // Returns a checksum so calls aren't optimized away
+}kernel;
+
+position positions[NO_POSITIONS];
+int pos_values[NO_POSITIONS];
+
+/* FUNCTIONS */
+long run_find_board_value(long rounds);
+long run_find_pos_value(long rounds);
+long run_is_winning(long rounds);
+long run_score_moves(long rounds);
+long run_is_dead(long rounds);
+long run_rotate_board(long rounds);
+long run_compare_boards(long rounds);
+long run_canonical_position(long rounds);
+long run_position_key(long rounds);
+
+void fill_positions(uint64_t seed);
+
+int main(int argc, char *argv[])
+{
+    long rounds = DEFAULT_ROUNDS;
+    uint64_t seed = DEFAULT_SEED;
+
+    // Read options
+    char *value;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((value = option_value(argc, argv, &i, "-r", "--rounds")) != NULL)
+        {
+            rounds = strtol(value, NULL, 10);
+        }
+        else if ((value = option_value(argc, argv, &i, "-s", "--seed")) != NULL)
+        {
+            seed = strtoull(value, NULL, 10);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-r | --rounds <number>] [-s | --seed <number>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const kernel kernels[NO_KERNELS] = {{"find_board_value",   "boards",    run_find_board_value},
+                                        {"find_pos_value",     "positions", run_find_pos_value},
+                                        {"is_winning",         "positions", run_is_winning},
+                                        {"score_moves",        "positions", run_score_moves},
+                                        {"is_dead",            "boards",    run_is_dead},
+                                        {"rotate_board",       "boards",    run_rotate_board},
+                                        {"compare_boards",     "boards",    run_compare_boards},
+                                        {"canonical_position", "positions", run_canonical_position},
+                                        {"position_key",       "positions", run_position_key}};
+
+    fill_positions(seed);
+
+    // Run kernels & print results
+    printf("{\n");
+    printf("  \"rounds\": %ld,\n", rounds);
+    printf("  \"seed\": %llu,\n", (unsigned long long) seed);
+    printf("  \"kernels\": [\n");
+
+    for (int i = 0; i < NO_KERNELS; i++)
+    {
+        long calls = rounds * (strcmp(kernels[i].inputs, "boards") ? NO_POSITIONS : NO_CONFIGS);
+
+        long start = now_ns();
+        long checksum = kernels[i].run(rounds);
+        long elapsed = now_ns() - start;
+
+        printf("    {\"name\": \"%s\", \"inputs\": \"%s\", \"calls\": %ld, \"ns\": %ld, \"ns_per_call\": %.3f, \"checksum\": %ld}%s\n",
+               kernels[i].name, kernels[i].inputs, calls, elapsed, (double) elapsed / calls, checksum,
+               (i == NO_KERNELS - 1) ? "" : ",");
+    }
+
+    printf("  ]\n");
+    printf("}\n");
+
+    return 0;
+}
+
+/* Kernels */
+long run_find_board_value(long rounds)
+{
+    long checksum = 0;
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_CONFIGS; j++)
+        {
+            checksum += find_board_value(j);
+        }
+    }
+
+    return checksum;
+}
+
+long run_find_pos_value(long rounds)
+{
+    long checksum = 0;
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_POSITIONS; j++)
+        {
+            checksum += find_pos_value(positions[j]);
+        }
+    }
+
+    return checksum;
+}
+
+long run_is_winning(long rounds)
+{
+    long checksum = 0;
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_POSITIONS; j++)
+        {
+            checksum += is_winning(pos_values[j]);
+        }
+    }
+
+    return checksum;
+}
+
+long run_score_moves(long rounds)
+{
+    long checksum = 0;
+    int scores[NO_MOVES];
+
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_POSITIONS; j++)
+        {
+            checksum += score_moves(positions[j], scores) + scores[i % NO_MOVES];
+        }
+    }
+
+    return checksum;
+}
+
+long run_is_dead(long rounds)
+{
+    long checksum = 0;
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_CONFIGS; j++)
+        {
+            checksum += is_dead(j);
+        }
+    }
+
+    return checksum;
+}
+
+long run_rotate_board(long rounds)
+{
+    long checksum = 0;
+    int rotations[NO_ROTATIONS];
+
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_CONFIGS; j++)
+        {
+            rotate_board(j, rotations);
+            checksum += rotations[i % NO_ROTATIONS];
+        }
+    }
+
+    return checksum;
+}
+
+long run_compare_boards(long rounds)
+{
+    long checksum = 0;
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_CONFIGS; j++)
+        {
+            checksum += compare_boards(j, (j + i) % NO_CONFIGS);
+        }
+    }
+
+    return checksum;
+}
+
+long run_canonical_position(long rounds)
+{
+    long checksum = 0;
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_POSITIONS; j++)
+        {
+            checksum += canonical_position(positions[j]);
+        }
+    }
+
+    return checksum;
+}
+
+long run_position_key(long rounds)
+{
+    long checksum = 0;
+    for (long i = 0; i < rounds; i++)
+    {
+        for (int j = 0; j < NO_POSITIONS; j++)
+        {
+            checksum += position_key(positions[j]);
+        }
+    }
+
+    return checksum;
+}
+
+// Fill random positions & their values
+void fill_positions(uint64_t seed)
+{
+    engine eng;
+    init_engine(&eng, seed);
+
+    for (int i = 0; i < NO_POSITIONS; i++)
+    {
+        positions[i] = engine_random(&eng) & ((MOVE_BIT(NO_BOARDS * BOARD_BITS)) - 1);
+        pos_values[i] = find_pos_value(positions[i]);
+    }
+}
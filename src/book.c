@@ -0,0 +1,161 @@
+/* Opening book -> memory mapped file of engine replies in early positions */
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "book.h"
+#include "bytes.h"
+#include "engine.h"
+#include "position.h"
+#include "symmetry.h"
+
+/* FUNCTIONS */
+void write_book_header(unsigned char header[BOOK_HEADER_SIZE], uint32_t no_entries);
+void write_book_entry(unsigned char data[BOOK_ENTRY_SIZE], book_entry *entry);
+book_entry read_book_entry(const unsigned char *book, uint32_t index);
+
+int load_book(engine *eng, char *file_name);
+void unload_book(engine *eng);
+
+int book_move(engine *eng, position pos);
+
+// Encode header of a book file
+void write_book_header(unsigned char header[BOOK_HEADER_SIZE], uint32_t no_entries)
+{
+    memset(header, 0, BOOK_HEADER_SIZE);
+
+    memcpy(header, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    write_uint32(header + 8, BOOK_VERSION);
+    write_uint32(header + 12, no_entries);
+}
+
+// Encode an entry of a book file
+void write_book_entry(unsigned char data[BOOK_ENTRY_SIZE], book_entry *entry)
+{
+    write_uint16(data, entry -> key);
+    write_uint16(data + 2, entry -> move);
+}
+
+// Decode an entry of a mapped book file
+book_entry read_book_entry(const unsigned char *book, uint32_t index)
+{
+    const unsigned char *data = book + BOOK_HEADER_SIZE + index * BOOK_ENTRY_SIZE;
+
+    book_entry entry;
+    entry.key = read_uint16(data);
+    entry.move = read_uint16(data + 2);
+
+    return entry;
+}
+
+// Map a book file into memory & use it in engine
+// Returns 1: loaded, 0: file missing or invalid
+int load_book(engine *eng, char *file_name)
+{
+    int fd = open(file_name, O_RDONLY);
+    if (fd == -1)
+    {
+        return 0;
+    }
+
+    // Check file size against header
+    struct stat st;
+    unsigned char header[BOOK_HEADER_SIZE];
+    uint32_t no_entries = 0;
+
+    if (fstat(fd, &st) == -1 || read(fd, header, BOOK_HEADER_SIZE) != BOOK_HEADER_SIZE ||
+        memcmp(header, BOOK_MAGIC, sizeof(BOOK_MAGIC)) || read_uint32(header + 8) != BOOK_VERSION ||
+        (no_entries = read_uint32(header + 12)) > NO_POSITION_KEYS ||
+        (size_t) st.st_size != BOOK_HEADER_SIZE + (size_t) no_entries * BOOK_ENTRY_SIZE)
+    {
+        close(fd);
+        return 0;
+    }
+
+    size_t size = st.st_size;
+
+    // Pages are shared with every process using the same file
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        return 0;
+    }
+
+    // Check entries -> sorted keys & legal moves in their positions
+    // An illegal move would be played on a taken cell or a dead board
+    int last_key = -1;
+
+    for (uint32_t i = 0; i < no_entries; i++)
+    {
+        book_entry entry = read_book_entry((const unsigned char *) map, i);
+
+        if (entry.key >= NO_POSITION_KEYS || entry.move >= NO_MOVES || entry.key <= last_key ||
+            (key_position(entry.key) & MOVE_BIT(entry.move)) ||
+            is_dead(GET_BOARD(key_position(entry.key), entry.move / BOARD_BITS)))
+        {
+            munmap(map, size);
+            return 0;
+        }
+
+        last_key = entry.key;
+    }
+
+    unload_book(eng);
+
+    eng -> book = (const unsigned char *) map;
+    eng -> book_size = size;
+    eng -> book_entries = no_entries;
+
+    return 1;
+}
+
+// Unmap engine's book
+void unload_book(engine *eng)
+{
+    if (eng -> book != NULL)
+    {
+        munmap((void *) eng -> book, eng -> book_size);
+    }
+
+    eng -> book = NULL;
+    eng -> book_size = 0;
+    eng -> book_entries = 0;
+}
+
+// Look up engine's reply in a position
+// Returns move index, -1 if the position isn't in the book
+int book_move(engine *eng, position pos)
+{
+    int order[NO_BOARDS];
+    int key = key_order(pos, order);
+
+    // Binary search
+    int low = 0;
+    int high = eng -> book_entries - 1;
+
+    while (low <= high)
+    {
+        int middle = (low + high) / 2;
+        book_entry entry = read_book_entry(eng -> book, middle);
+
+        if (entry.key == key)
+        {
+            return key_move(pos, order, entry.move);
+        }
+        else if (entry.key < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    return -1;
+}
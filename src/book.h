@@ -0,0 +1,35 @@
+#ifndef BOOK_H_INCLUDED
+#define BOOK_H_INCLUDED
+
+#include <stdint.h>
+
+#include "engine.h"
+#include "position.h"
+
+/* DEFINITIONS */
+#define BOOK_MAGIC   "NOTAKBK"
+#define BOOK_VERSION 1
+
+// Header -> magic (8 bytes), version & number of entries (4 bytes each), followed by entries sorted by key
+// Entry -> key & move (2 bytes each)
+// Numbers are little endian, written a byte at a time
+#define BOOK_HEADER_SIZE 16
+#define BOOK_ENTRY_SIZE  4
+
+/* Book entry -> engine's reply in a position, as a move of key_position(key) */
+typedef struct book_entry
+{
+    uint16_t key;
+    uint16_t move;
+}book_entry;
+
+/* FUNCTIONS */
+void write_book_header(unsigned char header[BOOK_HEADER_SIZE], uint32_t no_entries);
+void write_book_entry(unsigned char data[BOOK_ENTRY_SIZE], book_entry *entry);
+
+int load_book(engine *eng, char *file_name);
+void unload_book(engine *eng);
+
+int book_move(engine *eng, position pos);
+
+#endif
@@ -0,0 +1,43 @@
+/* Little endian numbers of save, book & tablebase files */
+#include "bytes.h"
+
+/* FUNCTIONS */
+void write_uint16(unsigned char *data, uint16_t number);
+void write_uint32(unsigned char *data, uint32_t number);
+uint16_t read_uint16(const unsigned char *data);
+uint32_t read_uint32(const unsigned char *data);
+
+// Write a 2 byte number
+void write_uint16(unsigned char *data, uint16_t number)
+{
+    data[0] = number;
+    data[1] = number >> 8;
+}
+
+// Write a 4 byte number
+void write_uint32(unsigned char *data, uint32_t number)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        data[i] = number >> (8 * i);
+    }
+}
+
+// Read a 2 byte number
+uint16_t read_uint16(const unsigned char *data)
+{
+    return data[0] | (uint16_t) data[1] << 8;
+}
+
+// Read a 4 byte number
+uint32_t read_uint32(const unsigned char *data)
+{
+    uint32_t number = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        number |= (uint32_t) data[i] << (8 * i);
+    }
+
+    return number;
+}
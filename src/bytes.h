@@ -0,0 +1,14 @@
+#ifndef BYTES_H_INCLUDED
+#define BYTES_H_INCLUDED
+
+#include <stdint.h>
+
+/* Numbers in files -> little endian, a byte at a time, same files on every machine */
+
+/* FUNCTIONS */
+void write_uint16(unsigned char *data, uint16_t number);
+void write_uint32(unsigned char *data, uint32_t number);
+uint16_t read_uint16(const unsigned char *data);
+uint32_t read_uint32(const unsigned char *data);
+
+#endif
@@ -1,540 +1,246 @@
 /* Engine used in computer mode */
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
-#include "moves.h" 
+#include "book.h"
+#include "engine.h"
+#include "tablebase.h"
 
 /* DEFINITIONS */
-#define BOARD_VALUE  2
-#define POS_VALUE    6
-
-#define NO_BOARDS    3
-#define NO_ROTATIONS 8
-
-// Board values
-#define A 2
-#define B 3
-#define C 4
-#define D 5
-
-// Number of configurations possible for each number of Xs
-#define ZERO_X  1
-#define ONE_X   3 
-#define TWO_X   8 
-#define THREE_X 13
-#define FOUR_X  15 
-#define FIVE_X  5
-#define SIX_X   1
-
-/* Structure to hold boards & their corresponding values */
-typedef struct boardValue
-{
-    int board[3][3];
-    int value[BOARD_VALUE];
-}boardValue;
-
-extern int boards[NO_BOARDS][3][3];
-extern int dead_boards[NO_BOARDS];
-
-/* BOARDS CONFIGURATIONS */
-// All possible configs (except dead boards)
-// Boards with the same no. of Xs are grouped into arrays
-const boardValue X0[ZERO_X] = {   {{{0, 0, 0},                     // Configuration 1
-                                    {0, 0, 0},
-                                    {0, 0, 0}}, {C, 0}}   };
-
-const boardValue X1[ONE_X] =  {   {{{1, 0, 0},                     // Configuration 1
-                                    {0, 0, 0},
-                                    {0, 0, 0}}, {1, 0}},
-
-                                  {{{0, 1, 0},                     // Configuration 2
-                                    {0, 0, 0},
-                                    {0, 0, 0}}, {1, 0}},
-
-                                  {{{0, 0, 0},                     // Configuration 3
-                                    {0, 1, 0},
-                                    {0, 0, 0}}, {C, C}}   };
-
-const boardValue X2[TWO_X] = {    {{{1, 1, 0},                     // Configuration 1
-                                    {0, 0, 0},
-                                    {0, 0, 0}}, {A, D}},
-
-                                  {{{1, 0, 1},                     // Configuration 2
-                                    {0, 0, 0},
-                                    {0, 0, 0}}, {B, 0}},
-
-                                  {{{1, 0, 0},                     // Configuration 3
-                                    {0, 1, 0},
-                                    {0, 0, 0}}, {B, 0}},
-
-                                  {{{1, 0, 0},                     // Configuration 4
-                                    {0, 0, 1},
-                                    {0, 0, 0}}, {B, 0}},
-
-                                  {{{1, 0, 0},                     // Configuration 5
-                                    {0, 0, 0},
-                                    {0, 0, 1}}, {A, 0}},
-
-                                  {{{0, 1, 0},                     // Configuration 6
-                                    {1, 0, 0},
-                                    {0, 0, 0}}, {A, 0}},
-
-                                  {{{0, 1, 0},                     // Configuration 7
-                                    {0, 1, 0},
-                                    {0, 0, 0}}, {B, 0}},
-
-                                  {{{0, 1, 0},                     // Configuration 8
-                                    {0, 0, 0},
-                                    {0, 1, 0}}, {A, 0}}   };
-
-const boardValue X3[THREE_X] = {  {{{1, 1, 0},                     // Configuration 1
-                                    {1, 0, 0},
-                                    {0, 0, 0}}, {B, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 2
-                                    {0, 1, 0},
-                                    {0, 0, 0}}, {A, B}},
-
-                                  {{{1, 1, 0},                     // Configuration 3
-                                    {0, 0, 1},
-                                    {0, 0, 0}}, {D, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 4
-                                    {0, 0, 0},
-                                    {1, 0, 0}}, {A, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 5
-                                    {0, 0, 0},
-                                    {0, 1, 0}}, {D, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 6
-                                    {0, 0, 0},
-                                    {0, 0, 1}}, {D, 0}},
-
-                                  {{{1, 0, 1},                     // Configuration 7
-                                    {0, 1, 0},
-                                    {0, 0, 0}}, {A, 0}},
-
-                                  {{{1, 0, 1},                     // Configuration 8
-                                    {0, 0, 0},
-                                    {1, 0, 0}}, {A, B}},
-
-                                  {{{1, 0, 1},                     // Configuration 9
-                                    {0, 0, 0},
-                                    {0, 1, 0}}, {A, 0}},
-
-                                  {{{1, 0, 0},                     // Configuration 10
-                                    {0, 1, 1},
-                                    {0, 0, 0}}, {A, 0}},
-
-                                  {{{1, 0, 0},                     // Configuration 11
-                                    {0, 0, 1},
-                                    {0, 1, 0}}, {1, 0}},
-
-                                  {{{0, 1, 0},                     // Configuration 12
-                                    {1, 1, 0},
-                                    {0, 0, 0}}, {A, B}},
-
-                                  {{{0, 1, 0},                     // Configuration 13
-                                    {1, 0, 1},
-                                    {0, 0, 0}}, {B, 0}}   };
-
-const boardValue X4[FOUR_X] = {   {{{1, 1, 0},                     // Configuration 1
-                                    {1, 1, 0},
-                                    {0, 0, 0}}, {A, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 2
-                                    {1, 0, 1},
-                                    {0, 0, 0}}, {A, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 3
-                                    {1, 0, 0},
-                                    {0, 0, 1}}, {A, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 4
-                                    {0, 1, 1},
-                                    {0, 0, 0}}, {B, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 5
-                                    {0, 1, 0},
-                                    {1, 0, 0}}, {B, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 6
-                                    {0, 0, 1},
-                                    {1, 0, 0}}, {B, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 7
-                                    {0, 0, 1},
-                                    {0, 1, 0}}, {A, B}},
-
-                                  {{{1, 1, 0},                     // Configuration 8
-                                    {0, 0, 1},
-                                    {0, 0, 1}}, {A, B}},
-
-                                  {{{1, 1, 0},                     // Configuration 9
-                                    {0, 0, 0},
-                                    {1, 1, 0}}, {B, 0}},
-
-                                  {{{1, 1, 0},                     // Configuration 10
-                                    {0, 0, 0},
-                                    {1, 0, 1}}, {B, 0}},
+// Quotient tables -> generated by gen_values.c
+extern const int board_values[];
+extern const int value_products[NO_VALUES][NO_VALUES];
+extern const int p_positions[NO_VALUES];
+extern const unsigned short winning_cells[][NO_VALUES];
+extern const unsigned short killing_cells[];
 
-                                  {{{1, 1, 0},                     // Configuration 11
-                                    {0, 0, 0},
-                                    {0, 1, 1}}, {A, 0}},
-
-                                  {{{1, 0, 1},                     // Configuration 12
-                                    {0, 1, 0},
-                                    {0, 1, 0}}, {B, 0}},
-
-                                  {{{1, 0, 1},                     // Configuration 13
-                                    {0, 0, 0},
-                                    {1, 0, 1}}, {A, 0}},
+/* FUNCTIONS */
+void init_engine(engine *eng, uint64_t seed);
+void seed_engine(engine *eng, uint64_t seed);
+uint64_t engine_random(engine *eng);
 
-                                  {{{1, 0, 0},                     // Configuration 14
-                                    {0, 1, 1},
-                                    {0, 1, 0}}, {B, 0}},
+int choose_move(engine *eng, position pos);
+int score_moves(position pos, int scores[NO_MOVES]);
+void find_move_cells(position pos, int empty[NO_BOARDS], int wins[NO_BOARDS], int kills[NO_BOARDS]);
 
-                                  {{{0, 1, 0},                     // Configuration 15
-                                    {1, 0, 1},
-                                    {0, 1, 0}}, {A, 0}}   };
+int is_winning(int pos_value);
+int find_pos_value(position pos);
+int find_board_value(int board);
+int multiply_values(int value1, int value2);
 
-const boardValue X5[FIVE_X] = {   {{{1, 1, 0},                     // Configuration 1
-                                    {1, 0, 1},
-                                    {0, 1, 0}}, {B, 0}},
-                                      
-                                  {{{1, 1, 0},                     // Configuration 2
-                                    {1, 0, 1},
-                                    {0, 0, 1}}, {B, 0}},
+// Initialize engine -> quotient tables & a seeded random stream
+void init_engine(engine *eng, uint64_t seed)
+{
+    memset(eng, 0, sizeof(engine));
+    seed_engine(eng, seed);
+}
 
-                                  {{{1, 1, 0},                     // Configuration 3
-                                    {0, 1, 1},
-                                    {1, 0, 0}}, {A, 0}},
+// Seed engine's random stream
+// State is expanded from the seed using splitmix64
+void seed_engine(engine *eng, uint64_t seed)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        seed += 0x9E3779B97F4A7C15;
 
-                                  {{{1, 1, 0},                     // Configuration 4
-                                    {0, 0, 1},
-                                    {1, 1, 0}}, {A, 0}},
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
 
-                                  {{{1, 1, 0},                     // Configuration 5
-                                    {0, 0, 1},
-                                    {1, 0, 1}}, {A, 0}}   };
+        eng -> random_state[i] = z ^ (z >> 31);
+    }
+}
 
-const boardValue X6[SIX_X] = {    {{{1, 1, 0},                     // Configuration 1
-                                    {1, 0, 1},
-                                    {0, 1, 1}}, {A, 0}}   };
+// Next number of engine's random stream -> xoshiro256**
+uint64_t engine_random(engine *eng)
+{
+    uint64_t *s = eng -> random_state;
+    uint64_t result = s[1] * 5;
+    result = ((result << 7) | (result >> 57)) * 9;
 
-/* FUNCTIONS */
-void choose_move();
+    uint64_t t = s[1] << 17;
 
-int is_winning(int pos_value[POS_VALUE]);
-void find_pos_value(int pos[NO_BOARDS][3][3], int pos_value[POS_VALUE]);
-void find_board_value(int board[3][3], int value[BOARD_VALUE]);
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
 
-int compare();
-int compare_boards(int board1[3][3], int board2[3][3]);
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
 
-void rotate_board(int board[3][3], int rotations[NO_ROTATIONS][3][3]);
+    return result;
+}
 
-// Choose move to play
-void choose_move()
+// Choose move to play in a position
+// Returns move index (9 * board + 3 * y + x), -1 if the game is finished
+int choose_move(engine *eng, position pos)
 {
-    int copy[NO_BOARDS][3][3];
-
-    int move_scores[27];            // Used to determine non-losing moves
-    int losing_counter = 0;
-    int non_losing_counter = 0;
-
-    // Try moves
-    int found_move = 0;
-    for (int i = 0; i < NO_BOARDS; i++)
+    // Opening book -> no evaluation at all
+    if (eng -> book != NULL)
     {
-        if (!dead_boards[i])
+        int move = book_move(eng, pos);
+
+        if (move != -1)
         {
-            for (int j = 0; j < 3; j++)
-            {
-                for (int k = 0; k < 3; k++)
-                {
-                    if (!boards[i][j][k])
-                    {
-                        // Create copy of boards
-                        memcpy(copy, boards, sizeof(int) * NO_BOARDS * 3 * 3);
-
-                        // Play move & find position value
-                        int pos_value[POS_VALUE];
-                        copy[i][j][k] = 1;
-
-                        find_pos_value(copy, pos_value);
-                        if (is_winning(pos_value))
-                        {
-                            found_move = 1;
-                            boards[i][j][k] = 1;
-
-                            goto play_move;
-                        }
-                        else
-                        {
-                            if ((dead_boards[(i + 1) % 3] && dead_boards[(i + 2) % 3]) && is_dead(copy[i]))
-                            {
-                                move_scores[26 - (losing_counter++)] = i * 9 + j * 3 + k;
-                            }
-                            else
-                            {
-                                move_scores[non_losing_counter++] = i * 9 + j * 3 + k;
-                            }
-                        }
-                    }
-                }
-            }
+            return move;
         }
     }
 
-play_move:
-    if (!found_move)
+    if (eng -> tablebase != NULL)
     {
-        srand(time(NULL));
-    
-        int x, y, z, rand_move, rand_choice;
-
-        // Moves that don't lose the game
-        if (non_losing_counter)
-        {
-            rand_choice = rand() % non_losing_counter;
-            rand_move = move_scores[rand_choice];
-        }
-        // All moves lose the game
-        else
-        {
-            rand_choice = rand() % losing_counter;
-            rand_move = move_scores[26 - rand_choice];
-        }
-
-        x = rand_move / 9;
-        y = (rand_move - x * 9) / 3;
-        z = (rand_move - x * 9 - y * 3);
-
-        boards[x][y][z] = 1;
+        return tablebase_move(eng, pos);
     }
-}
 
-// Evaluate position value 
-// Returns 1: if winnning, 0: otherwise
-int is_winning(int pos_value[POS_VALUE])
-{
-    // Count each character 
-    int A_counter, B_counter, C_counter, D_counter;
-    A_counter = B_counter = C_counter = D_counter = 0;
-    
-    for (int i = 0; i < POS_VALUE; i++)
+    int empty[NO_BOARDS], wins[NO_BOARDS], kills[NO_BOARDS];
+    find_move_cells(pos, empty, wins, kills);
+
+    // Winning move -> first winning cell of the first board that has one
+    for (int i = 0; i < NO_BOARDS; i++)
     {
-        switch (pos_value[i])
+        if (wins[i])
         {
-            case A:
-                A_counter++;
-                break;
-            case B:
-                B_counter++;
-                break;
-            case C:
-                C_counter++;
-                break;
-            case D:
-                D_counter++;
-                break;
+            return i * BOARD_BITS + __builtin_ctz(wins[i]);
         }
     }
 
-    // Check if value is winning
-    if (A_counter == 1 && !B_counter && !C_counter && !D_counter)
-    {
-        return 1;
-    }
-    else if (B_counter == 2 && !A_counter && !C_counter && !D_counter)
+    // No winning move -> random move that doesn't kill the last board
+    int cells[NO_BOARDS];
+    int non_losing_counter = 0;
+    int losing_counter = 0;
+
+    for (int i = 0; i < NO_BOARDS; i++)
     {
-        return 1;
+        non_losing_counter += __builtin_popcount(empty[i] & ~kills[i]);
+        losing_counter += __builtin_popcount(kills[i]);
     }
-    else if (B_counter == 1 && C_counter == 1 && !A_counter && !D_counter)
+
+    // No moves left
+    if (!non_losing_counter && !losing_counter)
     {
-        return 1;
+        return -1;
     }
-    else if (C_counter == 2 && !A_counter && !B_counter && !D_counter)
+
+    // Moves that don't lose the game
+    if (non_losing_counter)
     {
-        return 1;
+        for (int i = 0; i < NO_BOARDS; i++)
+        {
+            cells[i] = empty[i] & ~kills[i];
+        }
     }
+    // All moves lose the game
     else
     {
-        return 0;
+        for (int i = 0; i < NO_BOARDS; i++)
+        {
+            cells[i] = kills[i];
+        }
     }
-}
 
-// Find position value
-void find_pos_value(int pos[NO_BOARDS][3][3], int pos_value[POS_VALUE])
-{
-    int where = 0;
+    int rand_choice = engine_random(eng) % (non_losing_counter ? non_losing_counter : losing_counter);
+
+    // Find chosen cell in move order
     for (int i = 0; i < NO_BOARDS; i++)
     {
-        // Find board value
-        int board_value[BOARD_VALUE];
-        find_board_value(pos[i], board_value);
+        int count = __builtin_popcount(cells[i]);
 
-        // Add board value to position value
-        for (int j = 0; j < BOARD_VALUE; j++)
+        if (rand_choice >= count)
         {
-            pos_value[where++] = board_value[j];
+            rand_choice -= count;
+            continue;
         }
-    }
-}
 
-// Compares board to configurations to find its value 
-void find_board_value(int board[3][3], int value[BOARD_VALUE])
-{
-    // Find number of Xs
-    int x_counter = 0;
-    for (int i = 0; i < 3; i++)
-    {
-        for (int j = 0; j < 3; j++)
+        while (rand_choice--)
         {
-            x_counter += board[i][j];
+            cells[i] &= cells[i] - 1;
         }
-    }
 
-    // Compare to configurations
-    switch (x_counter)
-    {
-        case 0:
-            // Only one value
-            value[0] = X0[0].value[0];
-            value[1] = X0[0].value[1];
-            return;
-        case 1:
-            for (int i = 0; i < ONE_X; i++)
-            {
-                if (compare(board, X1[i]))
-                {
-                    value[0] = X1[i].value[0];
-                    value[1] = X1[i].value[1];
-                    return;
-                }
-            }
-            break;
-        case 2:
-            for (int i = 0; i < TWO_X; i++)
-            {
-                if (compare(board, X2[i]))
-                {
-                    value[0] = X2[i].value[0];
-                    value[1] = X2[i].value[1];
-                    return;
-                }
-            }
-            break;
-        case 3:
-            for (int i = 0; i < THREE_X; i++)
-            {
-                if (compare(board, X3[i]))
-                {
-                    value[0] = X3[i].value[0];
-                    value[1] = X3[i].value[1];
-                    return;
-                }
-            }
-            break;
-        case 4:
-            for (int i = 0; i < FOUR_X; i++)
-            {
-                if (compare(board, X4[i]))
-                {
-                    value[0] = X4[i].value[0];
-                    value[1] = X4[i].value[1];
-                    return;
-                }
-            }
-            break;
-        case 5:
-            for (int i = 0; i < FIVE_X; i++)
-            {
-                if (compare(board, X5[i]))
-                {
-                    value[0] = X5[i].value[0]; 
-                    value[1] = X5[i].value[1];
-                    return;
-                }
-            }
-            break;
-        case 6:
-            // Only one configuration 
-            if (compare(board, X6[0]))
-            {
-                value[0] = X6[0].value[0];
-                value[1] = X6[0].value[1];
-                return;
-            }
+        return i * BOARD_BITS + __builtin_ctz(cells[i]);
     }
 
-    // Dead board
-    value[0] = 1;
-    value[1] = 0;
-    return;
+    return -1;
 }
 
-// Compares board with a configuration
-// Returns 1: if the same, 0: otherwise
-int compare(int board[3][3], boardValue config)
+// Classify every move of a position in one pass
+// scores -> filled with a move class (MOVE_*) per move index
+// Returns number of legal moves, 0 if the game is finished
+int score_moves(position pos, int scores[NO_MOVES])
 {
-    // Find all rotations of a configuration
-    int rotations[NO_ROTATIONS][3][3];
-    rotate_board(config.board, rotations);
+    int legal_counter = 0;
 
-    // Compare board with rotations
-    for (int i = 0; i < NO_ROTATIONS; i++)
+    int empty[NO_BOARDS], wins[NO_BOARDS], kills[NO_BOARDS];
+    find_move_cells(pos, empty, wins, kills);
+
+    for (int i = 0; i < NO_BOARDS; i++)
     {
-        if (compare_boards(board, rotations[i]))
+        legal_counter += __builtin_popcount(empty[i]);
+
+        for (int j = 0; j < BOARD_BITS; j++)
         {
-            return 1;
+            int cell = 1 << j;
+
+            scores[i * BOARD_BITS + j] = !(empty[i] & cell) ? MOVE_ILLEGAL   :
+                                          (wins[i] & cell)  ? MOVE_WINNING   :
+                                          (kills[i] & cell) ? MOVE_SELF_KILL : MOVE_LOSING;
         }
     }
 
-    return 0;
+    return legal_counter;
 }
 
-// Compare two boards
-int compare_boards(int board1[3][3], int board2[3][3])
+// Find cells of every board by move class -> bit j: cell j of the board
+// empty -> legal moves, wins -> winning moves, kills -> moves that kill the last board
+void find_move_cells(position pos, int empty[NO_BOARDS], int wins[NO_BOARDS], int kills[NO_BOARDS])
 {
-    for (int i = 0; i < 3; i++)
+    // Cache board values & the product of the other boards' values
+    // A move changes one board only -> one lookup per board for each class
+    int cached_values[NO_BOARDS];
+    int dead_boards[NO_BOARDS];
+
+    for (int i = 0; i < NO_BOARDS; i++)
     {
-        for (int j = 0; j < 3; j++)
-        {
-            // If there's a difference
-            if (board1[i][j] != board2[i][j])
-            {
-                return 0;
-            }
-        }
+        cached_values[i] = find_board_value(GET_BOARD(pos, i));
+        dead_boards[i] = is_dead(GET_BOARD(pos, i));
     }
 
-    // There's no difference
-    return 1;
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        int board = GET_BOARD(pos, i);
+        int others_value = multiply_values(cached_values[(i + 1) % 3], cached_values[(i + 2) % 3]);
+
+        empty[i] = dead_boards[i] ? 0 : ~board & BOARD_MASK;
+        wins[i] = winning_cells[board][others_value];
+        kills[i] = (dead_boards[(i + 1) % 3] && dead_boards[(i + 2) % 3]) ? killing_cells[board] : 0;
+    }
 }
 
-// Produce all (8) possible rotations of a board configuration
-// Fills array with 8 boards
-void rotate_board(int board[3][3], int rotations[NO_ROTATIONS][3][3])
+// Evaluate position value 
+// Returns 1: if winnning (a P-position for the opponent), 0: otherwise
+int is_winning(int pos_value)
 {
-    for (int i = 0; i < 3; i++)
+    return p_positions[pos_value];
+}
+
+// Find position value -> product of all board values
+int find_pos_value(position pos)
+{
+    int pos_value = IDENTITY;
+    for (int i = 0; i < NO_BOARDS; i++)
     {
-        for (int j = 0; j < 3; j++)
-        {
-            rotations[0][i][j] = board[i][j];
-            rotations[1][i][j] = board[i][2 - j];
+        pos_value = value_products[pos_value][board_values[GET_BOARD(pos, i)]];
+    }
 
-            rotations[2][i][j] = board[j][i];
-            rotations[3][i][j] = board[j][2 - i];
+    return pos_value;
+}
 
-            rotations[4][i][j] = board[2 - i][j];
-            rotations[5][i][j] = board[2 - i][2 - j];
+// Find board value
+int find_board_value(int board)
+{
+    return board_values[board];
+}
 
-            rotations[6][i][j] = board[2 - j][i];
-            rotations[7][i][j] = board[2 - j][2 - i];
-        }
-    }
+// Combine values of two (groups of) boards
+int multiply_values(int value1, int value2)
+{
+    return value_products[value1][value2];
 }
@@ -1,25 +1,51 @@
 #ifndef ENGINE_H_INCLUDED 
 #define ENGINE_H_INCLUDED
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "position.h"
+
 /* DEFINITIONS */
-#define BOARD_VALUE  2
-#define POS_VALUE    6
+#define NO_VALUES    18                 // Elements of the misere quotient
+#define IDENTITY     0
 
 #define NO_BOARDS    3
 #define NO_ROTATIONS 8
+#define NO_MOVES     27
+
+// Move classes -> scored for the player to move
+#define MOVE_ILLEGAL   0                // Cell taken or on a dead board
+#define MOVE_WINNING   1                // Leaves opponent a losing position
+#define MOVE_LOSING    2                // Leaves opponent a winning position
+#define MOVE_SELF_KILL 3                // Kills the last board -> loses at once
+
+/* Engine state -> owned by a single game or thread */
+typedef struct engine
+{
+    uint64_t random_state[4];           // xoshiro256** random stream
+
+    const unsigned char *tablebase;     // Mapped tablebase file, NULL -> use quotient tables
+    size_t tablebase_size;
 
-typedef struct boardValue boardValue;
+    const unsigned char *book;          // Mapped opening book, NULL -> no book
+    size_t book_size;
+    int book_entries;
+}engine;
 
 /* FUNCTIONS */
-void choose_move();
+void init_engine(engine *eng, uint64_t seed);
+void seed_engine(engine *eng, uint64_t seed);
+uint64_t engine_random(engine *eng);
 
-int is_winning(int pos_value[POS_VALUE]);
-void find_pos_value(int pos[NO_BOARDS][3][3], int pos_value[POS_VALUE]);
-void find_board_value(int board[3][3], int value[BOARD_VALUE]);
+int choose_move(engine *eng, position pos);
+int score_moves(position pos, int scores[NO_MOVES]);
 
-int compare();
-int compare_boards(int board1[3][3], int board2[3][3]);
+int is_winning(int pos_value);
+int find_pos_value(position pos);
+int find_board_value(int board);
+int multiply_values(int value1, int value2);
 
-void rotate_board(int board[3][3], int rotations[NO_ROTATIONS][3][3]);
+extern const char *value_names[NO_VALUES];
 
 #endif 
@@ -3,7 +3,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
 #include "moves.h"
+#include "position.h"
 
 /* DEFINITIONS */
 #define HUMAN_MODE 0
@@ -29,7 +31,7 @@ WINDOW *status_win;
 WINDOW *stats_win;
 WINDOW *endgame_win;
 
-extern int boards[NO_BOARDS][3][3];
+extern position boards;
 extern int which_mode;
 
 /* FUNCTIONS */
@@ -47,10 +49,11 @@ void print_instructions();
 
 void print_side_menu(int which_win, int is_used);
 void print_boards(int x, int y);
-void print_board(int board[3][3], WINDOW *board_win);
+void print_board(int board, WINDOW *board_win);
 void print_menu(int which);
 void print_status(int turn);
-void print_stats(int engine_games[2], int two_user_games[2]);
+void print_spinner(int frame);
+void print_stats(int engine_games[2], int two_user_games[2], arena *session_arena);
 void print_end_msg(int who_won);
 void print_error(int error_num, int which_win);
 
@@ -116,7 +119,7 @@ int create_windows()
         boards_win[2] = newwin(height, width, y, x + width * 2 + 8 * 2);
 
         // Create menu window -> inside main window
-        height = 12;
+        height = 13;
         width = 50;
         y = (rows - height - 9) / 2;
         x = (cols - width) / 2;
@@ -241,7 +244,6 @@ void exit_game(int code)
     {
         delwin(exit_win);
         destroy_windows();
-        clear_stacks();
 
         endwin();
         exit(code);
@@ -457,7 +459,7 @@ void print_boards(int x, int y)
     // Print boards without highlighting
     for (int i = 0; i < NO_BOARDS; i++)
     {
-        print_board(boards[i], boards_win[i]);
+        print_board(GET_BOARD(boards, i), boards_win[i]);
     }
 
     // Find which board has highlighted element
@@ -473,7 +475,7 @@ void print_boards(int x, int y)
     // Find highlighted element character -> X if 1, empty space if 0
     char highlighted;
 
-    highlighted = (boards[which_board][y][x]) ? 'X' : ' ';
+    highlighted = (x >= 0 && y >= 0 && GET_CELL(boards, which_board, y, x)) ? 'X' : ' ';
 
     // Print highlighted element
     wattron(boards_win[which_board], A_BOLD);
@@ -490,7 +492,7 @@ void print_boards(int x, int y)
 }
 
 // Print a single board inside a given window -> no highlighting
-void print_board(int board[3][3], WINDOW *board_win)
+void print_board(int board, WINDOW *board_win)
 {
     // Grid
     char *grid[] = {" --- --- --- ",
@@ -521,7 +523,7 @@ void print_board(int board[3][3], WINDOW *board_win)
         for (int j = 2; j < GRID_WIDTH; j += 4)
         {
             // Print character 
-            switch (board[y][x])
+            switch (BOARD_CELL(board, y, x))
             {
                 case 0:
                     mvwaddch(board_win, i, j, ' ');
@@ -546,6 +548,8 @@ void print_menu(int which)
                     " - Continue",
                     " - Undo",
                     " - Redo",
+                    " - Switch variation",
+                    " - Go to move",
                     " - Save game",
                     " - Load game",
                     " - Playing stats",
@@ -555,12 +559,14 @@ void print_menu(int which)
                                 "     -> Continue                        ",
                                 "     -> Undo                            ",
                                 "     -> Redo                            ",
+                                "     -> Switch variation                ",
+                                "     -> Go to move                      ",
                                 "     -> Save game                       ",
                                 "     -> Load game                       ",
                                 "     -> Playing stats                   ",
                                 "     -> Quit                            "};
     
-    const int NO_MENU_CHOICES = 8;
+    const int NO_MENU_CHOICES = 10;
 
     // Print borders & tag
     wclear(menu_win);
@@ -639,8 +645,18 @@ void print_status(int turn)
     wrefresh(status_win);
 }
 
+// Print thinking indicator in status window while engine chooses a move
+// frame -> advanced every time the indicator is redrawn
+void print_spinner(int frame)
+{
+    const char spinner[] = "|/-\\";
+
+    mvwprintw(status_win, 1, 4, "Thinking %c  ", spinner[frame % 4]);
+    wrefresh(status_win);
+}
+
 // Print game stats 
-void print_stats(int engine_games[2], int two_user_games[2])
+void print_stats(int engine_games[2], int two_user_games[2], arena *session_arena)
 {
     // Clear main window
     wclear(main_win);
@@ -679,6 +695,8 @@ void print_stats(int engine_games[2], int two_user_games[2])
     mvwprintw(stats_win, 4, 0, "|");
     mvwprintw(stats_win, 5, 0, "| Two Player games : %3i  | Player 1 wins : %3i   | %%%2.2f", t_user_games, two_user_games[0], p1_wins);
     mvwprintw(stats_win, 6, 0, "|                         | Player 2 wins : %3i   | %%%2.2f"              , two_user_games[1], p2_wins);
+    mvwprintw(stats_win, 7, 0, "|");
+    mvwprintw(stats_win, 8, 0, "| Allocations      : %3li  | From system   : %3li   | %liB", session_arena -> allocations, session_arena -> system_allocations, session_arena -> bytes);
 
     char *prompt = "PRESS ANY KEY TO RETURN";
     mvwprintw(stats_win, STATS_WIN_HEIGHT - 1, (STATS_WIN_WIDTH - strlen(prompt)) / 2, "%s", prompt);
@@ -765,7 +783,10 @@ void print_error(int error_num, int which_win)
                           "Please increase terminal size ]",    // 7
                           "couldn't save game ]",               // 8
                           "file doesn't exist ]",               // 9
-                          "loading failed ]"};                  // 10
+                          "loading failed ]",                   // 10
+                          "engine is thinking ]",               // 11
+                          "no other variation ]",               // 12
+                          "no such move ]"};                    // 13
 
     // Get window size & printing position
     int rows, cols, y, x;
@@ -1,6 +1,8 @@
 #ifndef GAME_WINDOWS_H_INCLUDED
 #define GAME_WINDOWS_H_INCLUDED
 
+#include "arena.h"
+
 /* FUNCTIONS */
 int create_windows();
 void clear_windows();
@@ -16,10 +18,11 @@ void print_instructions();
 
 void print_side_menu(int which_win, int is_used);
 void print_boards(int x, int y);
-void print_board(int board[3][3], WINDOW *board_win);
+void print_board(int board, WINDOW *board_win);
 void print_menu(int which);
 void print_status(int turn);
-void print_stats(int engine_games[2], int two_user_games[2]);
+void print_spinner(int frame);
+void print_stats(int engine_games[2], int two_user_games[2], arena *session_arena);
 void print_end_msg(int who_won);
 void print_error(int error_num, int which_win);
 
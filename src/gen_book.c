@@ -0,0 +1,124 @@
+/* Generates the opening book file from the engine's own replies */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "book.h"
+#include "engine.h"
+#include "position.h"
+#include "symmetry.h"
+
+/* DEFINITIONS */
+#define DEFAULT_FILE  "notakto.book"
+#define DEFAULT_DEPTH 8                 // Plies from the empty position
+#define DEFAULT_SEED  1                 // Book replies are the same on every run
+
+int main(int argc, char *argv[])
+{
+    char *file_name = DEFAULT_FILE;
+    int depth = DEFAULT_DEPTH;
+
+    // Read options
+    for (int i = 1; i < argc; i++)
+    {
+        if ((!strcmp(argv[i], "-d") || !strcmp(argv[i], "--depth")) && i + 1 < argc)
+        {
+            depth = atoi(argv[++i]);
+        }
+        else if (argv[i][0] != '-')
+        {
+            file_name = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-d | --depth <plies>] [file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Find keys reachable within depth plies -> one ply at a time
+    static unsigned char reached[NO_POSITION_KEYS];
+    static int frontier[NO_POSITION_KEYS], next[NO_POSITION_KEYS];
+    int no_frontier = 1, no_next;
+
+    frontier[0] = position_key(0);
+    reached[frontier[0]] = 1;
+
+    for (int ply = 0; ply < depth && no_frontier; ply++)
+    {
+        no_next = 0;
+
+        for (int i = 0; i < no_frontier; i++)
+        {
+            position pos = key_position(frontier[i]);
+
+            for (int move = 0; move < NO_MOVES; move++)
+            {
+                int key;
+
+                if (is_dead(GET_BOARD(pos, move / BOARD_BITS)) || (pos & MOVE_BIT(move)) ||
+                    reached[key = position_key(pos | MOVE_BIT(move))])
+                {
+                    continue;
+                }
+
+                reached[key] = 1;
+                next[no_next++] = key;
+            }
+        }
+
+        memcpy(frontier, next, no_next * sizeof(int));
+        no_frontier = no_next;
+    }
+
+    // Reply of engine in every reached position that isn't finished
+    static book_entry entries[NO_POSITION_KEYS];
+    int no_entries = 0;
+
+    engine eng;
+    init_engine(&eng, DEFAULT_SEED);
+
+    for (int key = 0; key < NO_POSITION_KEYS; key++)
+    {
+        int move;
+
+        if (reached[key] && (move = choose_move(&eng, key_position(key))) != -1)
+        {
+            entries[no_entries].key = key;
+            entries[no_entries].move = move;
+            no_entries++;
+        }
+    }
+
+    // Write file
+    unsigned char header[BOOK_HEADER_SIZE];
+    write_book_header(header, no_entries);
+
+    FILE *book_file = fopen(file_name, "wb");
+    if (book_file == NULL)
+    {
+        fprintf(stderr, "gen_book: couldn't open %s\n", file_name);
+        return 1;
+    }
+
+    int written = fwrite(header, 1, BOOK_HEADER_SIZE, book_file) == BOOK_HEADER_SIZE;
+
+    for (int i = 0; i < no_entries && written; i++)
+    {
+        unsigned char data[BOOK_ENTRY_SIZE];
+        write_book_entry(data, &entries[i]);
+
+        written = fwrite(data, 1, BOOK_ENTRY_SIZE, book_file) == BOOK_ENTRY_SIZE;
+    }
+
+    if (!written)
+    {
+        fprintf(stderr, "gen_book: couldn't write %s\n", file_name);
+        fclose(book_file);
+        return 1;
+    }
+
+    fclose(book_file);
+
+    return 0;
+}
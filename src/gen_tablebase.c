@@ -0,0 +1,51 @@
+/* Generates the perfect play tablebase file using the exhaustive solver */
+#include <stdio.h>
+
+#include "position.h"
+#include "solver.h"
+#include "symmetry.h"
+#include "tablebase.h"
+
+/* DEFINITIONS */
+#define DEFAULT_FILE "notakto.tb"
+
+int main(int argc, char *argv[])
+{
+    char *file_name = (argc > 1) ? argv[1] : DEFAULT_FILE;
+
+    // Solve a position of every key
+    static unsigned char entries[TABLEBASE_ENTRIES];
+
+    for (int i = 0; i < TABLEBASE_ENTRIES; i++)
+    {
+        int distance;
+        int wins = solve(key_position(i), &distance);
+
+        entries[i] = (wins ? ENTRY_WINS : 0) | (distance & ENTRY_DISTANCE);
+    }
+
+    free_solver();
+
+    // Write file
+    unsigned char header[TABLEBASE_HEADER_SIZE];
+    write_tablebase_header(header);
+
+    FILE *tablebase_file = fopen(file_name, "wb");
+    if (tablebase_file == NULL)
+    {
+        fprintf(stderr, "gen_tablebase: couldn't open %s\n", file_name);
+        return 1;
+    }
+
+    if (fwrite(header, 1, TABLEBASE_HEADER_SIZE, tablebase_file) != TABLEBASE_HEADER_SIZE ||
+        fwrite(entries, 1, TABLEBASE_ENTRIES, tablebase_file) != TABLEBASE_ENTRIES)
+    {
+        fprintf(stderr, "gen_tablebase: couldn't write %s\n", file_name);
+        fclose(tablebase_file);
+        return 1;
+    }
+
+    fclose(tablebase_file);
+
+    return 0;
+}
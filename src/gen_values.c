@@ -0,0 +1,812 @@
+/* Generates board value, misere quotient, move, symmetry & hashing tables used by the engine */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "position.h"
+
+/* DEFINITIONS */
+#define BOARD_VALUE  2
+
+#define NO_CONFIGS   512
+
+#define NO_CANONICAL_BOARDS 47           // 46 alive boards up to rotation + dead board
+
+#define NO_MOVES     27
+#define ZOBRIST_SEED 0x4E4F54414B544FULL   // Fixed -> hashes are the same across builds
+
+#define NO_VALUES    18
+#define NO_WORDS     36                 // a^(0-1) b^(0-2) c^(0-2) d^(0-1)
+
+// Board values
+#define A 2
+#define B 3
+#define C 4
+#define D 5
+
+// Number of configurations possible for each number of Xs
+#define ZERO_X  1
+#define ONE_X   3 
+#define TWO_X   8 
+#define THREE_X 13
+#define FOUR_X  15 
+#define FIVE_X  5
+#define SIX_X   1
+
+/* Structure to hold boards & their corresponding values */
+typedef struct boardValue
+{
+    int board[3][3];
+    int value[BOARD_VALUE];
+}boardValue;
+
+/* BOARDS CONFIGURATIONS */
+// All possible configs (except dead boards)
+// Boards with the same no. of Xs are grouped into arrays
+const boardValue X0[ZERO_X] = {   {{{0, 0, 0},                     // Configuration 1
+                                    {0, 0, 0},
+                                    {0, 0, 0}}, {C, 0}}   };
+
+const boardValue X1[ONE_X] =  {   {{{1, 0, 0},                     // Configuration 1
+                                    {0, 0, 0},
+                                    {0, 0, 0}}, {1, 0}},
+
+                                  {{{0, 1, 0},                     // Configuration 2
+                                    {0, 0, 0},
+                                    {0, 0, 0}}, {1, 0}},
+
+                                  {{{0, 0, 0},                     // Configuration 3
+                                    {0, 1, 0},
+                                    {0, 0, 0}}, {C, C}}   };
+
+const boardValue X2[TWO_X] = {    {{{1, 1, 0},                     // Configuration 1
+                                    {0, 0, 0},
+                                    {0, 0, 0}}, {A, D}},
+
+                                  {{{1, 0, 1},                     // Configuration 2
+                                    {0, 0, 0},
+                                    {0, 0, 0}}, {B, 0}},
+
+                                  {{{1, 0, 0},                     // Configuration 3
+                                    {0, 1, 0},
+                                    {0, 0, 0}}, {B, 0}},
+
+                                  {{{1, 0, 0},                     // Configuration 4
+                                    {0, 0, 1},
+                                    {0, 0, 0}}, {B, 0}},
+
+                                  {{{1, 0, 0},                     // Configuration 5
+                                    {0, 0, 0},
+                                    {0, 0, 1}}, {A, 0}},
+
+                                  {{{0, 1, 0},                     // Configuration 6
+                                    {1, 0, 0},
+                                    {0, 0, 0}}, {A, 0}},
+
+                                  {{{0, 1, 0},                     // Configuration 7
+                                    {0, 1, 0},
+                                    {0, 0, 0}}, {B, 0}},
+
+                                  {{{0, 1, 0},                     // Configuration 8
+                                    {0, 0, 0},
+                                    {0, 1, 0}}, {A, 0}}   };
+
+const boardValue X3[THREE_X] = {  {{{1, 1, 0},                     // Configuration 1
+                                    {1, 0, 0},
+                                    {0, 0, 0}}, {B, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 2
+                                    {0, 1, 0},
+                                    {0, 0, 0}}, {A, B}},
+
+                                  {{{1, 1, 0},                     // Configuration 3
+                                    {0, 0, 1},
+                                    {0, 0, 0}}, {D, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 4
+                                    {0, 0, 0},
+                                    {1, 0, 0}}, {A, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 5
+                                    {0, 0, 0},
+                                    {0, 1, 0}}, {D, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 6
+                                    {0, 0, 0},
+                                    {0, 0, 1}}, {D, 0}},
+
+                                  {{{1, 0, 1},                     // Configuration 7
+                                    {0, 1, 0},
+                                    {0, 0, 0}}, {A, 0}},
+
+                                  {{{1, 0, 1},                     // Configuration 8
+                                    {0, 0, 0},
+                                    {1, 0, 0}}, {A, B}},
+
+                                  {{{1, 0, 1},                     // Configuration 9
+                                    {0, 0, 0},
+                                    {0, 1, 0}}, {A, 0}},
+
+                                  {{{1, 0, 0},                     // Configuration 10
+                                    {0, 1, 1},
+                                    {0, 0, 0}}, {A, 0}},
+
+                                  {{{1, 0, 0},                     // Configuration 11
+                                    {0, 0, 1},
+                                    {0, 1, 0}}, {1, 0}},
+
+                                  {{{0, 1, 0},                     // Configuration 12
+                                    {1, 1, 0},
+                                    {0, 0, 0}}, {A, B}},
+
+                                  {{{0, 1, 0},                     // Configuration 13
+                                    {1, 0, 1},
+                                    {0, 0, 0}}, {B, 0}}   };
+
+const boardValue X4[FOUR_X] = {   {{{1, 1, 0},                     // Configuration 1
+                                    {1, 1, 0},
+                                    {0, 0, 0}}, {A, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 2
+                                    {1, 0, 1},
+                                    {0, 0, 0}}, {A, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 3
+                                    {1, 0, 0},
+                                    {0, 0, 1}}, {A, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 4
+                                    {0, 1, 1},
+                                    {0, 0, 0}}, {B, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 5
+                                    {0, 1, 0},
+                                    {1, 0, 0}}, {B, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 6
+                                    {0, 0, 1},
+                                    {1, 0, 0}}, {B, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 7
+                                    {0, 0, 1},
+                                    {0, 1, 0}}, {A, B}},
+
+                                  {{{1, 1, 0},                     // Configuration 8
+                                    {0, 0, 1},
+                                    {0, 0, 1}}, {A, B}},
+
+                                  {{{1, 1, 0},                     // Configuration 9
+                                    {0, 0, 0},
+                                    {1, 1, 0}}, {B, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 10
+                                    {0, 0, 0},
+                                    {1, 0, 1}}, {B, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 11
+                                    {0, 0, 0},
+                                    {0, 1, 1}}, {A, 0}},
+
+                                  {{{1, 0, 1},                     // Configuration 12
+                                    {0, 1, 0},
+                                    {0, 1, 0}}, {B, 0}},
+
+                                  {{{1, 0, 1},                     // Configuration 13
+                                    {0, 0, 0},
+                                    {1, 0, 1}}, {A, 0}},
+
+                                  {{{1, 0, 0},                     // Configuration 14
+                                    {0, 1, 1},
+                                    {0, 1, 0}}, {B, 0}},
+
+                                  {{{0, 1, 0},                     // Configuration 15
+                                    {1, 0, 1},
+                                    {0, 1, 0}}, {A, 0}}   };
+
+const boardValue X5[FIVE_X] = {   {{{1, 1, 0},                     // Configuration 1
+                                    {1, 0, 1},
+                                    {0, 1, 0}}, {B, 0}},
+                                      
+                                  {{{1, 1, 0},                     // Configuration 2
+                                    {1, 0, 1},
+                                    {0, 0, 1}}, {B, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 3
+                                    {0, 1, 1},
+                                    {1, 0, 0}}, {A, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 4
+                                    {0, 0, 1},
+                                    {1, 1, 0}}, {A, 0}},
+
+                                  {{{1, 1, 0},                     // Configuration 5
+                                    {0, 0, 1},
+                                    {1, 0, 1}}, {A, 0}}   };
+
+const boardValue X6[SIX_X] = {    {{{1, 1, 0},                     // Configuration 1
+                                    {1, 0, 1},
+                                    {0, 1, 1}}, {A, 0}}   };
+
+/* MISERE QUOTIENT */
+// Q = < a, b, c, d | a^2 = 1, b^3 = b, b^2 c = c, c^3 = a c^2, b^2 d = d, c d = a d, d^2 = c^2 >
+// P = { a, b^2, b c, c^2 } -> values of positions the player to move loses
+// Elements are held as exponents -> a^e[0] b^e[1] c^e[2] d^e[3]
+typedef struct element
+{
+    int e[4];
+}element;
+
+const element p_elements[4] = {{{1, 0, 0, 0}},               // a
+                               {{0, 2, 0, 0}},               // b^2
+                               {{0, 1, 1, 0}},               // b c
+                               {{0, 0, 2, 0}}};              // c^2
+
+element elements[NO_WORDS];
+int no_elements = 0;
+
+/* SYMMETRIES */
+int canonical_boards[NO_CONFIGS];
+int board_ids[NO_CONFIGS];
+int id_boards[NO_CANONICAL_BOARDS];
+int no_ids = 0;
+
+// Rotation of every board giving its canonical form & cell of a board each rotated cell comes from
+int canonical_rotations[NO_CONFIGS];
+int rotation_cells[NO_ROTATIONS][BOARD_BITS];
+
+/* FUNCTIONS */
+void find_board_value(int board, int value[BOARD_VALUE]);
+int compare(int board, boardValue config);
+
+void find_elements();
+element reduce(element x);
+element multiply(element x, element y);
+element letter_element(int letter);
+int element_index(element x);
+void element_name(element x, char *name);
+element board_element(int board);
+int is_p_element(element x);
+
+void print_board_values();
+void print_products();
+void print_p_positions();
+void print_names();
+void print_move_tables();
+
+void find_symmetries();
+void print_symmetry_tables();
+
+void print_zobrist_keys();
+
+// Print tables of board values, quotient arithmetic & symmetries as C source
+int main(void)
+{
+    find_elements();
+
+    if (no_elements != NO_VALUES)
+    {
+        fprintf(stderr, "gen_values: quotient has %d elements, expected %d\n", no_elements, NO_VALUES);
+        return 1;
+    }
+
+    find_symmetries();
+
+    if (no_ids != NO_CANONICAL_BOARDS - 1)
+    {
+        fprintf(stderr, "gen_values: found %d alive canonical boards, expected %d\n", no_ids, NO_CANONICAL_BOARDS - 1);
+        return 1;
+    }
+
+    printf("/* Generated by gen_values.c -> do not edit */\n");
+    printf("#include <stdint.h>\n");
+
+    print_board_values();
+    print_products();
+    print_p_positions();
+    print_names();
+    print_move_tables();
+    print_symmetry_tables();
+    print_zobrist_keys();
+
+    return 0;
+}
+
+// Find all elements of the quotient in normal form -> identity first
+void find_elements()
+{
+    element x;
+
+    for (x.e[3] = 0; x.e[3] < 2; x.e[3]++)
+    {
+        for (x.e[2] = 0; x.e[2] < 3; x.e[2]++)
+        {
+            for (x.e[1] = 0; x.e[1] < 3; x.e[1]++)
+            {
+                for (x.e[0] = 0; x.e[0] < 2; x.e[0]++)
+                {
+                    element reduced = reduce(x);
+
+                    if (element_index(reduced) == -1)
+                    {
+                        elements[no_elements++] = reduced;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Reduce an element to its normal form using the quotient relations
+element reduce(element x)
+{
+    // d^2 = c^2
+    while (x.e[3] >= 2)
+    {
+        x.e[3] -= 2;
+        x.e[2] += 2;
+    }
+
+    // c^3 = a c^2
+    while (x.e[2] >= 3)
+    {
+        x.e[2] -= 1;
+        x.e[0] += 1;
+    }
+
+    if (x.e[3])
+    {
+        // c d = a d
+        x.e[0] += x.e[2];
+        x.e[2] = 0;
+
+        // b^2 d = d
+        x.e[1] %= 2;
+    }
+    else if (x.e[2])
+    {
+        // b^2 c = c
+        x.e[1] %= 2;
+    }
+    else
+    {
+        // b^3 = b
+        while (x.e[1] >= 3)
+        {
+            x.e[1] -= 2;
+        }
+    }
+
+    // a^2 = 1
+    x.e[0] %= 2;
+
+    return x;
+}
+
+// Multiply two elements
+element multiply(element x, element y)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        x.e[i] += y.e[i];
+    }
+
+    return reduce(x);
+}
+
+// Element of a letter used in configuration values -> 1 & 0 are the identity
+element letter_element(int letter)
+{
+    element x = {{0, 0, 0, 0}};
+
+    if (letter >= A && letter <= D)
+    {
+        x.e[letter - A] = 1;
+    }
+
+    return x;
+}
+
+// Find index of an element (in normal form)
+// Returns index or -1 if not found
+int element_index(element x)
+{
+    for (int i = 0; i < no_elements; i++)
+    {
+        if (!memcmp(elements[i].e, x.e, sizeof(x.e)))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// Write name of an element -> e.g. "ab^2"
+void element_name(element x, char *name)
+{
+    const char letters[] = "abcd";
+
+    name[0] = '\0';
+    for (int i = 0; i < 4; i++)
+    {
+        if (x.e[i] == 1)
+        {
+            sprintf(name + strlen(name), "%c", letters[i]);
+        }
+        else if (x.e[i] > 1)
+        {
+            sprintf(name + strlen(name), "%c^%d", letters[i], x.e[i]);
+        }
+    }
+
+    if (!strlen(name))
+    {
+        strcpy(name, "1");
+    }
+}
+
+// Find quotient element of a board mask
+element board_element(int board)
+{
+    int value[BOARD_VALUE];
+    find_board_value(board, value);
+
+    return multiply(letter_element(value[0]), letter_element(value[1]));
+}
+
+// Check if an element is a P-position -> 1: player to move loses, 0: otherwise
+int is_p_element(element x)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (!memcmp(x.e, p_elements[i].e, sizeof(x.e)))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Print value of every board mask
+void print_board_values()
+{
+    printf("\n// Board values (quotient elements) indexed by board mask\n");
+    printf("const int board_values[%d] = {\n", NO_CONFIGS);
+
+    for (int i = 0; i < NO_CONFIGS; i++)
+    {
+        printf("%s%2d%s", (i % 16) ? " " : "    ", element_index(board_element(i)), (i == NO_CONFIGS - 1) ? "\n" : ((i % 16 == 15) ? ",\n" : ","));
+    }
+
+    printf("};\n");
+}
+
+// Print multiplication table of the quotient
+void print_products()
+{
+    printf("\n// Products of quotient elements\n");
+    printf("const int value_products[%d][%d] = {\n", NO_VALUES, NO_VALUES);
+
+    for (int i = 0; i < NO_VALUES; i++)
+    {
+        printf("    {");
+        for (int j = 0; j < NO_VALUES; j++)
+        {
+            printf("%2d%s", element_index(multiply(elements[i], elements[j])), (j == NO_VALUES - 1) ? "" : ", ");
+        }
+        printf("}%s\n", (i == NO_VALUES - 1) ? "" : ",");
+    }
+
+    printf("};\n");
+}
+
+// Print P-positions flags -> 1: player to move loses, 0: otherwise
+void print_p_positions()
+{
+    printf("\n// P-positions of the quotient\n");
+    printf("const int p_positions[%d] = {", NO_VALUES);
+
+    for (int i = 0; i < NO_VALUES; i++)
+    {
+        printf("%d%s", is_p_element(elements[i]), (i == NO_VALUES - 1) ? "" : ", ");
+    }
+
+    printf("};\n");
+}
+
+// Print names of quotient elements
+void print_names()
+{
+    printf("\n// Names of quotient elements\n");
+    printf("const char *value_names[%d] = {", NO_VALUES);
+
+    for (int i = 0; i < NO_VALUES; i++)
+    {
+        char name[16];
+        element_name(elements[i], name);
+
+        printf("\"%s\"%s", name, (i == NO_VALUES - 1) ? "" : ", ");
+    }
+
+    printf("};\n");
+}
+
+// Print cells of every board that win next to every value of the other boards & cells that kill it
+// Bit j set -> playing cell j leaves the opponent a P-position / completes a line
+void print_move_tables()
+{
+    printf("\n// Winning cells indexed by board mask & value of the other boards\n");
+    printf("const unsigned short winning_cells[%d][%d] = {\n", NO_CONFIGS, NO_VALUES);
+
+    for (int i = 0; i < NO_CONFIGS; i++)
+    {
+        printf("    {");
+        for (int j = 0; j < NO_VALUES; j++)
+        {
+            int cells = 0;
+            for (int k = 0; k < BOARD_BITS && !is_dead(i); k++)
+            {
+                if (!(i & (1 << k)) && is_p_element(multiply(board_element(i | (1 << k)), elements[j])))
+                {
+                    cells |= 1 << k;
+                }
+            }
+
+            printf("%3d%s", cells, (j == NO_VALUES - 1) ? "" : ", ");
+        }
+        printf("}%s\n", (i == NO_CONFIGS - 1) ? "" : ",");
+    }
+
+    printf("};\n");
+
+    printf("\n// Cells that kill a board indexed by board mask\n");
+    printf("const unsigned short killing_cells[%d] = {\n", NO_CONFIGS);
+
+    for (int i = 0; i < NO_CONFIGS; i++)
+    {
+        int cells = 0;
+        for (int k = 0; k < BOARD_BITS && !is_dead(i); k++)
+        {
+            if (!(i & (1 << k)) && is_dead(i | (1 << k)))
+            {
+                cells |= 1 << k;
+            }
+        }
+
+        printf("%s%3d%s", (i % 16) ? " " : "    ", cells, (i == NO_CONFIGS - 1) ? "\n" : ((i % 16 == 15) ? ",\n" : ","));
+    }
+
+    printf("};\n");
+}
+
+// Find canonical form & canonical id of every board
+// Canonical form -> smallest rotation, all dead boards are reduced to a full board
+// Alive boards are numbered by their canonical form, dead boards share the last id
+void find_symmetries()
+{
+    for (int i = 0; i < NO_CONFIGS; i++)
+    {
+        if (is_dead(i))
+        {
+            canonical_boards[i] = BOARD_MASK;
+            board_ids[i] = NO_CANONICAL_BOARDS - 1;
+            continue;
+        }
+
+        int rotations[NO_ROTATIONS];
+        rotate_board(i, rotations);
+
+        canonical_boards[i] = i;
+        canonical_rotations[i] = 0;
+        for (int j = 0; j < NO_ROTATIONS; j++)
+        {
+            if (rotations[j] < canonical_boards[i])
+            {
+                canonical_boards[i] = rotations[j];
+                canonical_rotations[i] = j;
+            }
+        }
+
+        // Boards are visited in order -> canonical form is numbered first
+        if (canonical_boards[i] == i)
+        {
+            if (no_ids < NO_CANONICAL_BOARDS - 1)
+            {
+                id_boards[no_ids] = i;
+            }
+
+            board_ids[i] = no_ids++;
+        }
+        else
+        {
+            board_ids[i] = board_ids[canonical_boards[i]];
+        }
+    }
+
+    id_boards[NO_CANONICAL_BOARDS - 1] = BOARD_MASK;
+
+    // Rotate single cells
+    for (int i = 0; i < BOARD_BITS; i++)
+    {
+        int rotations[NO_ROTATIONS];
+        rotate_board(1 << i, rotations);
+
+        for (int j = 0; j < NO_ROTATIONS; j++)
+        {
+            rotation_cells[j][__builtin_ctz(rotations[j])] = i;
+        }
+    }
+}
+
+// Print canonical form, canonical id & canonical rotation of every board
+void print_symmetry_tables()
+{
+    printf("\n// Canonical form of every board\n");
+    printf("const int canonical_boards[%d] = {\n", NO_CONFIGS);
+    for (int i = 0; i < NO_CONFIGS; i++)
+    {
+        printf("%s%3d%s", (i % 16) ? " " : "    ", canonical_boards[i], (i == NO_CONFIGS - 1) ? "\n" : ((i % 16 == 15) ? ",\n" : ","));
+    }
+    printf("};\n");
+
+    printf("\n// Canonical id of every board\n");
+    printf("const int board_ids[%d] = {\n", NO_CONFIGS);
+    for (int i = 0; i < NO_CONFIGS; i++)
+    {
+        printf("%s%2d%s", (i % 16) ? " " : "    ", board_ids[i], (i == NO_CONFIGS - 1) ? "\n" : ((i % 16 == 15) ? ",\n" : ","));
+    }
+    printf("};\n");
+
+    printf("\n// Canonical board of every id\n");
+    printf("const int id_boards[%d] = {\n", NO_CANONICAL_BOARDS);
+    for (int i = 0; i < NO_CANONICAL_BOARDS; i++)
+    {
+        printf("%s%3d%s", (i % 16) ? " " : "    ", id_boards[i], (i == NO_CANONICAL_BOARDS - 1) ? "\n" : ((i % 16 == 15) ? ",\n" : ","));
+    }
+    printf("};\n");
+
+    printf("\n// Rotation giving canonical form of every board\n");
+    printf("const int canonical_rotations[%d] = {\n", NO_CONFIGS);
+    for (int i = 0; i < NO_CONFIGS; i++)
+    {
+        printf("%s%d%s", (i % 16) ? " " : "    ", canonical_rotations[i], (i == NO_CONFIGS - 1) ? "\n" : ((i % 16 == 15) ? ",\n" : ","));
+    }
+    printf("};\n");
+
+    printf("\n// Cell every cell of a rotated board comes from\n");
+    printf("const int rotation_cells[%d][%d] = {\n", NO_ROTATIONS, BOARD_BITS);
+    for (int i = 0; i < NO_ROTATIONS; i++)
+    {
+        printf("    {");
+        for (int j = 0; j < BOARD_BITS; j++)
+        {
+            printf("%d%s", rotation_cells[i][j], (j == BOARD_BITS - 1) ? "" : ", ");
+        }
+        printf("}%s\n", (i == NO_ROTATIONS - 1) ? "" : ",");
+    }
+    printf("};\n");
+}
+
+// Print random key of every move -> splitmix64 stream from a fixed seed
+void print_zobrist_keys()
+{
+    uint64_t seed = ZOBRIST_SEED;
+
+    printf("\n// Zobrist key of every move\n");
+    printf("const uint64_t zobrist_keys[%d] = {\n", NO_MOVES);
+    for (int i = 0; i < NO_MOVES; i++)
+    {
+        seed += 0x9E3779B97F4A7C15;
+
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        z ^= z >> 31;
+
+        printf("    0x%016llXULL%s\n", (unsigned long long) z, (i == NO_MOVES - 1) ? "" : ",");
+    }
+    printf("};\n");
+}
+
+// Compares board to configurations to find its value 
+void find_board_value(int board, int value[BOARD_VALUE])
+{
+    // Find number of Xs
+    int x_counter = __builtin_popcount(board);
+
+    // Compare to configurations
+    switch (x_counter)
+    {
+        case 0:
+            // Only one value
+            value[0] = X0[0].value[0];
+            value[1] = X0[0].value[1];
+            return;
+        case 1:
+            for (int i = 0; i < ONE_X; i++)
+            {
+                if (compare(board, X1[i]))
+                {
+                    value[0] = X1[i].value[0];
+                    value[1] = X1[i].value[1];
+                    return;
+                }
+            }
+            break;
+        case 2:
+            for (int i = 0; i < TWO_X; i++)
+            {
+                if (compare(board, X2[i]))
+                {
+                    value[0] = X2[i].value[0];
+                    value[1] = X2[i].value[1];
+                    return;
+                }
+            }
+            break;
+        case 3:
+            for (int i = 0; i < THREE_X; i++)
+            {
+                if (compare(board, X3[i]))
+                {
+                    value[0] = X3[i].value[0];
+                    value[1] = X3[i].value[1];
+                    return;
+                }
+            }
+            break;
+        case 4:
+            for (int i = 0; i < FOUR_X; i++)
+            {
+                if (compare(board, X4[i]))
+                {
+                    value[0] = X4[i].value[0];
+                    value[1] = X4[i].value[1];
+                    return;
+                }
+            }
+            break;
+        case 5:
+            for (int i = 0; i < FIVE_X; i++)
+            {
+                if (compare(board, X5[i]))
+                {
+                    value[0] = X5[i].value[0]; 
+                    value[1] = X5[i].value[1];
+                    return;
+                }
+            }
+            break;
+        case 6:
+            // Only one configuration 
+            if (compare(board, X6[0]))
+            {
+                value[0] = X6[0].value[0];
+                value[1] = X6[0].value[1];
+                return;
+            }
+    }
+
+    // Dead board
+    value[0] = 1;
+    value[1] = 0;
+    return;
+}
+
+// Compares board with a configuration
+// Returns 1: if the same (up to rotation), 0: otherwise
+int compare(int board, boardValue config)
+{
+    // Pack configuration into a board mask
+    int config_board = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            config_board |= config.board[i][j] << (i * 3 + j);
+        }
+    }
+
+    return compare_boards(board, config_board);
+}
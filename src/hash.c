@@ -0,0 +1,30 @@
+/* Zobrist hashing of positions -> XOR of the keys of all played moves */
+#include <stdint.h>
+
+#include "hash.h"
+#include "position.h"
+
+/* FUNCTIONS */
+uint64_t hash_position(position pos);
+uint64_t hash_update(uint64_t hash, position from, position to);
+
+// Hash a position from scratch -> empty position hashes to 0
+uint64_t hash_position(position pos)
+{
+    return hash_update(0, 0, pos);
+}
+
+// Hash of position to, given hash of position from
+// Only moves that differ between the positions are XORed -> one per move on undo & redo
+uint64_t hash_update(uint64_t hash, position from, position to)
+{
+    position changed = from ^ to;
+
+    while (changed)
+    {
+        hash ^= zobrist_keys[__builtin_ctz(changed)];
+        changed &= changed - 1;
+    }
+
+    return hash;
+}
@@ -0,0 +1,21 @@
+#ifndef HASH_H_INCLUDED
+#define HASH_H_INCLUDED
+
+#include <stdint.h>
+
+#include "position.h"
+
+/* DEFINITIONS */
+#define NO_MOVES 27
+
+// Random key of every move -> generated by gen_values.c
+extern const uint64_t zobrist_keys[NO_MOVES];
+
+// Hash after playing / taking back a move -> XOR is its own inverse
+#define HASH_MOVE(hash, move) ((hash) ^ zobrist_keys[move])
+
+/* FUNCTIONS */
+uint64_t hash_position(position pos);
+uint64_t hash_update(uint64_t hash, position from, position to);
+
+#endif
@@ -1,10 +1,14 @@
 /* Main game screen */
 #include <ncurses.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
 #include "engine.h"
 #include "game_windows.h"
 #include "moves.h"
+#include "position.h"
+#include "worker.h"
 
 /* DEFINITIONS */
 #define BOARDS_WIN 0 
@@ -12,18 +16,29 @@
 
 #define NO_BOARDS 3
 
+// Time between input checks while engine thinks (ms)
+#define THINK_POLL 100
+
 // Menu choices
 #define RESTART  0
 #define CONTINUE 1
 #define UNDO     2
 #define REDO     3
-#define SAVE     4
-#define LOAD     5
-#define STATS    6
-#define QUIT     7
+#define SWITCH   4
+#define GO_TO    5
+#define SAVE     6
+#define LOAD     7
+#define STATS    8
+#define QUIT     9
+
+// Game boards -> packed position, set bit -> X, unset bit -> empty space
+position boards;
+
+// Memory of the current game -> released at once when the next game starts
+arena game_arena;
 
-// Game boards -> if element = 0 -> empty space, 1 -> X
-int boards[NO_BOARDS][3][3];
+// Zobrist hash of boards -> kept up to date by every move, undo, redo & load
+uint64_t boards_hash;
 
 // Determine if a board is dead -> 1: dead, 0: not
 int dead_boards[NO_BOARDS];
@@ -34,6 +49,12 @@ int two_user_games[2];        // 0: p 1 wins,  1: p 2 wins
 
 int which_mode;
 
+// Engine used in computer mode -> set up once per session
+engine *game_engine;
+
+// Thread running game engine -> UI keeps handling input while it thinks
+worker engine_worker;
+
 // turn =  1: computer or player 1
 //      = -1: User     or player 2
 int turn;
@@ -48,12 +69,13 @@ extern WINDOW *stats_win;
 extern WINDOW *endgame_win;
 
 /* FUNCTIONS */
-void init_game();
+void init_game(engine *eng);
 
 int play_two_user(int loaded);
 int play_compu(int loaded);
 
 int get_user_move();
+int get_engine_move();
 
 int navigate_boards(int ch, int *x_pr, int *y_pr, int *menu_choice);
 int use_menu();
@@ -72,7 +94,8 @@ int navigate_two_choices(int ch, int *which_pr);
 void print_options(WINDOW *which_win, char *prompt, char *highlighted[], char *not_highlighted[], int which);
 
 // Initialize game
-void init_game()
+// eng -> engine used in computer mode
+void init_game(engine *eng)
 {
     // Create windows needed in game
     int ch;
@@ -96,6 +119,17 @@ void init_game()
         engine_games[i] = two_user_games[i] = 0;
     }
 
+    game_engine = eng;
+
+    init_arena(&game_arena);
+
+    if (!start_worker(&engine_worker, game_engine))
+    {
+        endwin();
+        fprintf(stderr, "notakto: couldn't start engine thread\n");
+        exit(1);
+    }
+
     // Display static windows
     print_logo();
     print_instructions();
@@ -103,13 +137,14 @@ void init_game()
     initial_msg();
 
     // Play games until user quits
-    int who_won;
+    int who_won = 0;
     const int HUMAN_MODE = 0;
     const int COMPU_MODE = 1;
 
     do {
-        // Initialize undo & redo stacks
-        init_stacks();
+        // Release last game's memory & start an empty history
+        reset_arena(&game_arena);
+        clear_history();
 
         // New or loaded game
         int loaded_game = 0;
@@ -143,11 +178,10 @@ void init_game()
         {
             who_won = play_compu(loaded_game);
         }
-
-        clear_stacks();
-
     }while (who_won == 2 || !play_again(who_won));
     
+    stop_worker(&engine_worker);
+    free_arena(&game_arena);
     destroy_windows();
 }
 
@@ -165,7 +199,7 @@ int play_two_user(int loaded)
     print_side_menu(BOARDS_WIN, 0);
 
     // Play moves until the game ends or user restarts
-    while (!is_finished())
+    while (!is_finished(boards, dead_boards))
     {
         wclear(error_win);
         wrefresh(error_win);
@@ -222,18 +256,24 @@ int play_compu(int loaded)
     {
         print_status(1);
 
-        choose_move();
+        if (get_engine_move())
+        {
+            // Restart
+            return 2;
+        }
         print_boards(-1, -1);
     }
 
     // Play moves until game ends or user restarts
-    while (!is_finished())
+    while (!is_finished(boards, dead_boards))
     {
         print_status(turn);
 
-        // User to play
+        // User to play -> engine ponders replies meanwhile
         if (turn == -1)
         {
+            start_ponder(&engine_worker, boards);
+
             if (get_user_move())
             {
                 // Restart
@@ -243,7 +283,11 @@ int play_compu(int loaded)
         // Engine to play
         else if (turn == 1)
         {
-            choose_move();
+            if (get_engine_move())
+            {
+                // Restart
+                return 2;
+            }
         }
 
         turn *= -1;
@@ -321,6 +365,12 @@ int get_user_move()
                 case REDO:
                     redo();
                     break;
+                case SWITCH:
+                    switch_variation();
+                    break;
+                case GO_TO:
+                    go_to_move();
+                    break;
                 case SAVE:
                     save_game();
                     break;
@@ -328,7 +378,7 @@ int get_user_move()
                     load_game();
                     break;
                 case STATS:
-                    print_stats(engine_games, two_user_games);
+                    print_stats(engine_games, two_user_games, &game_arena);
                     break;
                 case QUIT:
                     exit_game(0);
@@ -358,6 +408,87 @@ next_move:
     return 0;
 }
 
+// Let engine choose a move on its thread & play it
+// Resizing, quitting & the menu keep working while it thinks
+// Returns 2: restart, 0: otherwise
+int get_engine_move()
+{
+    int move, ch, menu_choice;
+    int frame = 0;
+
+    request_move(&engine_worker, boards);
+
+    while (!wait_move(&engine_worker, &move, THINK_POLL))
+    {
+        print_spinner(frame++);
+
+        // Check input without blocking
+        timeout(0);
+        ch = getch();
+        timeout(-1);
+
+        menu_choice = -1;
+        switch (ch)
+        {
+            case KEY_RESIZE:
+                adjust_windows();
+                break;
+            case 's':
+                if (use_side_menu(BOARDS_WIN) == MENU_WIN)
+                {
+                    menu_choice = use_menu();
+                }
+                break;
+            case 'q':
+                menu_choice = QUIT;
+                break;
+            // No input or a key that does nothing here
+            default:
+                continue;
+        }
+
+        switch (menu_choice)
+        {
+            case RESTART:
+                cancel_move(&engine_worker);
+                return 2;
+            case QUIT:
+                // Game exits if user confirms -> drop move before asking
+                cancel_move(&engine_worker);
+                exit_game(0);
+                request_move(&engine_worker, boards);
+                break;
+            case STATS:
+                print_stats(engine_games, two_user_games, &game_arena);
+                break;
+            case UNDO:
+            case REDO:
+            case SWITCH:
+            case GO_TO:
+            case SAVE:
+            case LOAD:
+                print_error(11, 0);
+                break;
+        }
+
+        // Re-print boards
+        wclear(main_win);
+        box(main_win, 0, 0);
+        wrefresh(main_win);
+
+        redrawwin(error_win);
+        wrefresh(error_win);
+
+        print_side_menu(BOARDS_WIN, 0);
+        print_boards(-1, -1);
+        print_status(turn);
+    }
+
+    apply_move(move);
+
+    return 0;
+}
+
 // Navigate between boards
 // Returns 1: if user made a choice, 0: otherwise
 int navigate_boards(int ch, int *x_pr, int *y_pr, int *menu_choice)
@@ -474,7 +605,7 @@ int navigate_boards(int ch, int *x_pr, int *y_pr, int *menu_choice)
 // Use menu & return user choice
 int use_menu()
 {
-    const int NO_MENU_CHOICES = 8;
+    const int NO_MENU_CHOICES = 10;
 
     // Print on top of boards win
     wclear(main_win);
@@ -647,16 +778,11 @@ int use_side_menu(int which_win)
 // Fill boards with 0
 void fill_boards()
 {
+    boards = 0;
+    boards_hash = 0;
+
     for (int i = 0; i < NO_BOARDS; i++)
     {
-        for (int j = 0; j < 3; j++)
-        {
-            for (int k = 0; k < 3; k++)
-            {
-                boards[i][j][k] = 0;
-            }
-        }
-
         dead_boards[i] = 0;
     }
 }
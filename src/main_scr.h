@@ -1,8 +1,10 @@
 #ifndef MAIN_SCR_H_INCLUDED
 #define MAIN_SCR_H_INCLUDED
 
+#include "engine.h"
+
 /* FUNCTIONS */
-void init_game();
+void init_game(engine *eng);
 
 int play_two_user(int loaded);
 int play_compu(int loaded);
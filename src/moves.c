@@ -1,28 +1,54 @@
 /* Validate moves, save/load & undo/redo */
 #include <ncurses.h>
 #include <ctype.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h> 
 
+#include "arena.h"
 #include "game_windows.h"
+#include "hash.h"
+#include "position.h"
+#include "save.h"
 
 /* DEFINITIONS */
 #define NO_BOARDS 3
 
-/* node -> for undo & redo stacks */
-typedef struct node
-{
-    int value[NO_BOARDS][3][3];
-    struct node *next;
-}node;
-
-node *undo_stack;
-node *redo_stack;
-
-extern int boards[NO_BOARDS][3][3];
+// History node -> ply (bits 24 - 31) & index of its parent node (bits 0 - 23)
+#define MAKE_NODE(ply, parent) (((uint32_t) (ply) << 24) | (parent))
+#define NODE_PLY(node)         ((node) >> 24)
+#define NODE_PARENT(node)      ((int) ((node) & 0xFFFFFF))
+
+#define NODE_CHUNK  1024                // Nodes allocated at once from the game arena
+#define MAX_CHUNKS  16384               // Up to 2^24 nodes -> every parent index fits
+
+// History tree -> every ply played from history_base, node 0 is the root
+// Variations are never dropped, a node is 4 bytes in chunks of the game arena
+uint32_t *history_chunks[MAX_CHUNKS];
+int history_no_chunks;
+int history_size;                       // Nodes in tree
+
+// Shown variation -> plies in playing order, undone plies stay after the cursor
+// Undo & redo toggle single cells -> no snapshots
+unsigned char history[MAX_PLIES];
+int history_line[MAX_PLIES + 1];        // Node of every ply, history_line[0]: root
+int history_length;                     // Plies of variation, played & undone
+int history_cursor;                     // Played plies
+position history_base;                  // Position before the first ply
+
+// Checkpoints -> position after every CHECKPOINT_PLIES plies of shown variation
+// A seek replays plies from the checkpoint before it only
+#define CHECKPOINT_PLIES 8
+
+position history_checkpoints[MAX_PLIES / CHECKPOINT_PLIES + 1];
+int history_no_checkpoints;             // Checkpoints still matching variation, 0: base
+
+extern arena game_arena;
+extern position boards;
+extern uint64_t boards_hash;
 extern int dead_boards[NO_BOARDS];
 extern int which_mode;
 extern int turn;
@@ -30,37 +56,38 @@ extern WINDOW *main_win;
 
 /* FUNCTIONS */
 void play_move(int x, int y);
+void apply_move(int move);
 
 int is_valid(int x, int y);
-int is_finished();
-
-void mark_boards();
-int is_dead(int board[3][3]);
 
 void save_game();
 char *file_name_prompt();
+char *input_prompt(char *message, int digits_only);
 int write_game_data(char *file_name);
-void write_node(node *node_to_write, FILE *game_file);
 
 int load_game();
-int check_game_data(FILE *game_file, int *number_of_nodes);
-void read_game_data(FILE *game_file, int number_of_nodes);
-void read_undo_stack(FILE *game_file, int number_of_nodes);
+void restore_game(saved_game *game);
 
-node *create_node(int value[NO_BOARDS][3][3], node *next);
+void clear_history();
+void init_history(position base);
+void record_ply(int ply);
+void toggle_ply(int ply);
 
-void init_stacks();
-
-node *push(node *head, int value[NO_BOARDS][3][3]);
-node *pop(node *head);
-void replace_with_top(node *head);
+int follow_ply(int ply);
+void extend_line();
+int find_child(int parent, int ply);
+int add_node(int parent, int ply);
+uint32_t *history_node(int index);
 
 void undo();
 void redo();
+void switch_variation();
 
-void clear_stacks();
-void clear_undo();
-void clear_redo();
+void go_to_move();
+int seek_move(long move_number);
+void go_to_ply(int ply);
+position ply_position(int ply);
+void invalidate_checkpoints(int ply);
 
 // Play move on boards
 void play_move(int x, int y)
@@ -71,11 +98,13 @@ void play_move(int x, int y)
     which_board = x / 3;
     x %= 3;
 
-    // Push boards to undo stack & clear redo stack
-    undo_stack = push(undo_stack, boards);
-    clear_redo();
+    record_ply(MOVE_INDEX(which_board, y, x) | HUMAN_MOVE);
+}
 
-    boards[which_board][y][x] = 1;
+// Play engine's move on boards -> undone together with the user move before it
+void apply_move(int move)
+{
+    record_ply(move);
 }
 
 // Check if a move is valid
@@ -87,76 +116,7 @@ int is_valid(int x, int y)
     which_board = x / 3;
     x %= 3;
 
-    return !dead_boards[which_board] && !boards[which_board][y][x]; 
-}
-
-// Check if game is finished
-// Returns 1: finished, 0: not
-int is_finished()
-{
-    // Mark dead boards
-    mark_boards();
-
-    for (int i = 0; i < 3; i++)
-    {
-        if (!dead_boards[i])
-        {
-            return 0;
-        }
-    }
-
-    return 1 ;
-}
-
-// Mark dead boards
-void mark_boards()
-{
-    for (int i = 0; i < NO_BOARDS; i++)
-    {
-        dead_boards[i] = is_dead(boards[i]);
-    }
-}
-
-// Check if a board is dead
-int is_dead(int board[3][3])
-{
-    // Check vertical & horizontal
-    int v_sum, h_sum;
-
-    for (int i = 0; i < 3; i++)
-    {
-        v_sum = h_sum = 0;
-
-        for (int j = 0; j < 3; j++)
-        {
-            v_sum += board[j][i];
-            h_sum += board[i][j];
-        }
-
-        // Check for a straight line
-        if (v_sum == 3 || h_sum == 3)
-        {
-            return 1;
-        }
-    }
-
-    // Check diagonal
-    int d_sum1, d_sum2;
-    d_sum1 = d_sum2 = 0;
-
-    for (int i = 0; i < 3; i++)
-    {
-        d_sum1 += board[i][i];
-        d_sum2 += board[2 - i][i];
-    }
-
-    // Check for a straight line
-    if (d_sum1 == 3 || d_sum2 == 3)
-    {
-        return 1;
-    }
-
-    return 0;
+    return !dead_boards[which_board] && !GET_CELL(boards, which_board, y, x);
 }
 
 /* SAVE & LOAD GAMES */
@@ -176,8 +136,6 @@ void save_game()
         return;
     }
 
-    free(file_name);
-
     wclear(main_win);
     box(main_win, 0, 0);
 
@@ -196,6 +154,14 @@ void save_game()
 // Prompt user for a file name
 // Returns name of file to open or an empty string
 char *file_name_prompt()
+{
+    return input_prompt("Enter file name - Alphanumeric characters only", 0);
+}
+
+// Prompt user for a line of input
+// digits_only -> 1: accept digits only, 0: alphanumeric characters
+// Returns input or an empty string
+char *input_prompt(char *message, int digits_only)
 {
     const int MAX_INPUT_SIZE = 40;
 
@@ -203,7 +169,7 @@ char *file_name_prompt()
     getmaxyx(main_win, ROWS, COLS);
 
     // Print warning & prompt
-    char *prompt[]  = {"Enter file name - Alphanumeric characters only",
+    char *prompt[]  = {message,
                        "Press ENTER to proceed"};
 
     wclear(main_win);
@@ -231,7 +197,7 @@ char *file_name_prompt()
 
     int ch;
     int char_counter = 0;
-    char input_str[MAX_INPUT_SIZE];
+    char input_str[MAX_INPUT_SIZE + 1];
 
     while ((ch = wgetch(inner_box)) != 10)
     {
@@ -253,7 +219,7 @@ char *file_name_prompt()
             char_counter--;
         }
         // Add alphanumeric character
-        else if ((isalpha(ch) || isdigit(ch)) && char_counter < MAX_INPUT_SIZE)
+        else if ((isdigit(ch) || (!digits_only && isalpha(ch))) && char_counter < MAX_INPUT_SIZE)
         {
             input_str[char_counter++] = ch;
         }
@@ -277,8 +243,16 @@ char *file_name_prompt()
         return "";
     }
 
-    // Create a new string with the exact size to return
-    char *file_name = (char *) malloc(char_counter *sizeof(char));
+    // Create a new string with the exact size to return -> lives until next game
+    char *file_name = (char *) arena_alloc(&game_arena, (char_counter + 1) * sizeof(char));
+    if (file_name == NULL)
+    {
+        delwin(inner_box);
+        delwin(outer_box);
+        curs_set(0);
+        return "";
+    }
+
     for (int i = 0; i < char_counter; i++)
     {
         file_name[i] = input_str[i];
@@ -297,12 +271,13 @@ char *file_name_prompt()
 // Returns 1 : if correctly saved, 0 : otherwise
 int write_game_data(char *file_name)
 {
-    // Create a temporary stack reference
-    node *temp_stack = undo_stack;
-
     // Append directory name to file name
     char *dir_name = "saved-games/";
-    char *file = (char *) malloc((strlen(dir_name) + strlen(file_name)) * sizeof(char));    
+    char *file = (char *) arena_alloc(&game_arena, (strlen(dir_name) + strlen(file_name) + 1) * sizeof(char));
+    if (file == NULL)
+    {
+        return 0;
+    }
 
     strcat(strcpy(file, dir_name), file_name);
 
@@ -322,57 +297,21 @@ int write_game_data(char *file_name)
         return 0;
     }
 
-    // Write game data to file
-    // Game mode
-    fputc(which_mode, game_file);
-
-    // Turn
-    fputc(((turn == -1) ? 0 : turn), game_file);
-
-    // Dead boards array
-    for (int i = 0; i < NO_BOARDS; i++)
-    {
-        fputc(dead_boards[i], game_file);
-    }
+    // Shown variation & how much of it is played
+    saved_game game;
+    unsigned char data[MAX_SAVE_SIZE];
 
-    // Game boards
-    for (int i = 0; i < NO_BOARDS; i++)
-    {
-        for (int j = 0; j < 3; j++)
-        {
-            for (int k = 0; k < 3; k++)
-            {
-                fputc(boards[i][j][k], game_file);
-            }
-        }
-    }
+    game.mode = which_mode;
+    game.turn = turn;
+    game.base = history_base;
+    game.length = history_length;
+    game.cursor = history_cursor;
+    memcpy(game.plies, history, history_length);
 
-    // Undo stack nodes
-    while (temp_stack != NULL)
-    {
-        write_node(temp_stack, game_file);
-        temp_stack = temp_stack -> next;
-    }
+    int size = encode_save(&game, data);
+    int written = fwrite(data, 1, size, game_file) == (size_t) size;
 
-    free(file);
-    fclose(game_file);
-
-    return 1;
-}
-
-// Write node to a file
-void write_node(node *node_to_write, FILE *game_file)
-{
-    for (int i = 0; i < NO_BOARDS; i++)
-    {
-        for (int j = 0; j < 3; j++)
-        {
-            for (int k = 0; k < 3; k++)
-            {
-                fputc(node_to_write -> value[i][j][k], game_file);
-            }
-        }
-    }
+    return fclose(game_file) == 0 && written;
 }
 
 // Load previously saved game
@@ -392,13 +331,20 @@ int load_game()
 
     // Append directory name to file name
     char *dir_name = "saved-games/";
-    char *file = (char *) malloc((strlen(dir_name) + strlen(file_name)) * sizeof(char));
+    char *file = (char *) arena_alloc(&game_arena, (strlen(dir_name) + strlen(file_name) + 1) * sizeof(char));
+    if (file == NULL)
+    {
+        print_error(9, 1);
+        resize_or_quit(getch());
+
+        return 0;
+    }
 
     strcat(strcpy(file, dir_name), file_name);
 
     // Open file
     FILE *game_file;
-    game_file = fopen(file, "r");
+    game_file = fopen(file, "rb");
     if (game_file == NULL)
     {
         print_error(9, 1);
@@ -407,14 +353,28 @@ int load_game()
         return 0;
     }
 
-    // Check game data
-    int number_of_nodes;
-    if (check_game_data(game_file, &number_of_nodes))
+    // Whole file -> older saves keep every undo snapshot, no size limit
+    long size = -1;
+    unsigned char *data = NULL;
+
+    if (fseek(game_file, 0, SEEK_END) == 0 && (size = ftell(game_file)) >= 0 && size <= INT_MAX)
+    {
+        rewind(game_file);
+        data = (unsigned char *) arena_alloc(&game_arena, size + 1);
+    }
+
+    int loaded = data != NULL && fread(data, 1, size, game_file) == (size_t) size;
+    fclose(game_file);
+
+    // Versioned save -> header tells, older files are one byte per cell (0 or 1)
+    saved_game game;
+
+    if (loaded)
     {
-        // Read game data
-        read_game_data(game_file, number_of_nodes - 1);
+        loaded = is_save(data, size) ? decode_save(data, size, &game) : decode_old_save(data, size, &game);
     }
-    else
+
+    if (!loaded)
     {
         print_error(10, 1);
         resize_or_quit(getch());
@@ -422,233 +382,385 @@ int load_game()
         return 0;
     }
 
-    free(file);
-    free(file_name);
-    fclose(game_file);
+    restore_game(&game);
 
     return 1;
 }
 
-// Check game file data
-// Return 1: if data is correct, 0: if not
-int check_game_data(FILE *game_file, int *number_of_nodes)
+// Replace current game with a loaded one -> rebuild history & seek to the played ply
+void restore_game(saved_game *game)
 {
-    // Count characters & check their value
-    int ch;
-    int counter = 0;
+    position current = game -> base;
+    int cursor = game -> cursor;
 
-    while ((ch = fgetc(game_file)) != EOF)
+    for (int i = 0; i < cursor; i++)
     {
-        counter++;
+        current |= MOVE_BIT(game -> plies[i] & PLY_MOVE);
+    }
+
+    which_mode = game -> mode;
 
-        if (ch != 1 && ch != 0)
+    boards = game -> base;
+    boards_hash = hash_position(game -> base);
+    init_history(game -> base);
+
+    for (int i = 0; i < game -> length; i++)
+    {
+        // Out of memory -> history starts from current position
+        if (!follow_ply(game -> plies[i]))
         {
-            return 0;
+            init_history(current);
+            cursor = 0;
+            break;
         }
     }
 
-    if (!((counter - 5) % 27))
-    {
-        *number_of_nodes = ((counter - 5) / 27) - 1;
-        return 1;
-    }
-    else
+    go_to_ply(cursor);
+
+    turn = game -> turn;
+}
+
+/* UNDO & REDO */
+
+// Forget history tree's memory -> called once game arena is released
+void clear_history()
+{
+    history_no_chunks = 0;
+    init_history(0);
+}
+
+// Start an empty history from a position -> allocated chunks are reused
+void init_history(position base)
+{
+    history_size = 0;
+    history_line[0] = add_node(0, 0);
+
+    history_length = 0;
+    history_cursor = 0;
+    history_base = base;
+
+    history_checkpoints[0] = base;
+    history_no_checkpoints = 1;
+}
+
+// Play a ply & record it in history
+void record_ply(int ply)
+{
+    toggle_ply(ply);
+
+    // Out of memory -> history starts from current boards
+    if (!follow_ply(ply))
     {
-        return 0;
+        init_history(boards);
     }
 }
 
-// Read game data
-void read_game_data(FILE *game_file, int number_of_nodes)
+// Put or remove ply's X -> boards, hash & dead board updated in place
+void toggle_ply(int ply)
 {
-    // Read game data
-    fseek(game_file, 0, SEEK_SET);
+    int move = ply & PLY_MOVE;
+    int which_board = move / BOARD_BITS;
 
-    // Game mode
-    which_mode = fgetc(game_file);
+    boards ^= MOVE_BIT(move);
+    boards_hash = HASH_MOVE(boards_hash, move);
 
-    // Turn
-    turn = fgetc(game_file);
-    turn = (turn == 0) ? -1 : turn;
+    dead_boards[which_board] = is_dead(GET_BOARD(boards, which_board));
+}
 
-    // Dead boards array
-    for (int i = 0; i < NO_BOARDS; i++)
+// Move cursor of shown variation forward by a ply
+// A ply already in tree is shared, a ply different from the variation's switches to its branch
+// Returns 1: followed, 0: out of memory
+int follow_ply(int ply)
+{
+    // Same ply as variation -> keep what follows it
+    if (history_cursor < history_length && history[history_cursor] == ply)
     {
-        dead_boards[i] = fgetc(game_file);
+        history_cursor++;
+        return 1;
     }
 
-    // Game boards
-    for (int i = 0; i < NO_BOARDS; i++)
+    int parent = history_line[history_cursor];
+    int child = find_child(parent, ply);
+
+    // No root -> nothing can be recorded
+    if (parent == -1)
     {
-        for (int j = 0; j < 3; j++)
-        {
-            for (int k = 0; k < 3; k++)
-            {
-                boards[i][j][k] = fgetc(game_file); 
-            }
-        }
+        return 0;
     }
 
-    // Undo stack nodes
-    if (number_of_nodes >= 0)
+    if (child == -1 && (child = add_node(parent, ply)) == -1)
     {
-        init_stacks();
-        read_undo_stack(game_file, number_of_nodes);
+        return 0;
     }
+
+    invalidate_checkpoints(history_cursor);
+
+    history[history_cursor] = ply;
+    history_line[++history_cursor] = child;
+    history_length = history_cursor;
+
+    extend_line();
+
+    return 1;
 }
 
-// Read undo stack nodes from a file
-void read_undo_stack(FILE *game_file, int number_of_nodes)
+// Extend shown variation to a leaf -> latest child at every ply
+void extend_line()
 {
-    // Read node boards
-    int node_boards[NO_BOARDS][3][3];
+    int child;
 
-    for (int i = 0; i < NO_BOARDS; i++)
+    while (history_length < MAX_PLIES && (child = find_child(history_line[history_length], -1)) != -1)
     {
-        for (int j = 0; j < 3; j++)
-        {
-            for (int k = 0; k < 3; k++)
-            {
-                node_boards[i][j][k] = fgetc(game_file);
-            }
-        }
+        invalidate_checkpoints(history_length);
+
+        history[history_length] = NODE_PLY(*history_node(child));
+        history_line[++history_length] = child;
     }
+}
 
-    if (number_of_nodes)
+// Find latest child of a node -> children come after their parent
+// ply -> child's ply, -1: any
+// Returns node index, -1 if there's no such child
+int find_child(int parent, int ply)
+{
+    for (int i = history_size - 1; i > parent; i--)
     {
-        read_undo_stack(game_file, --number_of_nodes);
+        uint32_t node = *history_node(i);
+
+        if (NODE_PARENT(node) == parent && (ply == -1 || (int) NODE_PLY(node) == ply))
+        {
+            return i;
+        }
     }
 
-    // Push boards to undo stack
-    undo_stack = push(undo_stack, node_boards);
+    return -1;
 }
 
-/* UNDO & REDO */
-
-// Create node
-node *create_node(int value[NO_BOARDS][3][3], node *next)
+// Add node to history tree
+// Returns node index, -1 if out of memory
+int add_node(int parent, int ply)
 {
-    node *temp = (node *) malloc(sizeof(node));
-    
-    memcpy(temp -> value, value, sizeof(int) * 3 * 3 * 3);
-    temp -> next  = next;
+    // Chunks are full -> take a new one from game arena
+    if (history_size == history_no_chunks * NODE_CHUNK)
+    {
+        if (history_no_chunks == MAX_CHUNKS)
+        {
+            return -1;
+        }
 
-    return temp;
+        uint32_t *chunk = (uint32_t *) arena_alloc(&game_arena, NODE_CHUNK * sizeof(uint32_t));
+        if (chunk == NULL)
+        {
+            return -1;
+        }
+
+        history_chunks[history_no_chunks++] = chunk;
+    }
+
+    *history_node(history_size) = MAKE_NODE(ply, parent);
+
+    return history_size++;
 }
 
-// Initialize stacks
-void init_stacks()
+// Node of history tree by index
+uint32_t *history_node(int index)
 {
-    undo_stack = NULL;
-    redo_stack = NULL;
+    return &history_chunks[index / NODE_CHUNK][index % NODE_CHUNK];
 }
 
-// Push boards to stack -> return new head
-node *push(node *head, int value[NO_BOARDS][3][3])
+// Undo last user move & every ply after it
+void undo()
 {
-    node *temp = create_node(value, head);
-    return temp;
+    // Find last played user move
+    int last = history_cursor - 1;
+    while (last >= 0 && !(history[last] & HUMAN_MOVE))
+    {
+        last--;
+    }
+
+    // Nothing to undo
+    if (last < 0)
+    {
+        print_error(5, 0);
+        return;
+    }
+
+    while (history_cursor > last)
+    {
+        toggle_ply(history[--history_cursor]);
+    }
 }
 
-// Pop head of the stack -> return new head
-node *pop(node *head)
+// Redo next user move & the plies following it
+void redo()
 {
-    if (head != NULL)
+    // Nothing to redo
+    if (history_cursor == history_length)
     {
-        head = head -> next;
+        print_error(6, 0);
+        return;
     }
 
-    return head;
+    do {
+        toggle_ply(history[history_cursor++]);
+    }while (history_cursor < history_length && !(history[history_cursor] & HUMAN_MOVE));
 }
 
-// Replace game boards with the top of the stack 
-void replace_with_top(node *head)
+// Replace last user move with the next move played instead of it & follow that variation
+void switch_variation()
 {
-   for (int i = 0; i < 3; i++)
+    // Find last played user move
+    int last = history_cursor - 1;
+    while (last >= 0 && !(history[last] & HUMAN_MOVE))
     {
-        for (int j = 0; j < 3; j++)
+        last--;
+    }
+
+    if (last < 0)
+    {
+        print_error(12, 0);
+        return;
+    }
+
+    // Next user move from the same position -> wraps around to the first one
+    int parent = history_line[last];
+    int current = history_line[last + 1];
+    int first = -1, next = -1;
+
+    for (int i = parent + 1; i < history_size; i++)
+    {
+        uint32_t node = *history_node(i);
+
+        if (NODE_PARENT(node) != parent || !(NODE_PLY(node) & HUMAN_MOVE) || i == current)
         {
-            for (int k = 0; k < 3; k++)
-            {
-                boards[i][j][k] = head -> value[i][j][k];
-            }
+            continue;
+        }
+
+        if (first == -1)
+        {
+            first = i;
+        }
+
+        if (i > current)
+        {
+            next = i;
+            break;
         }
     }
-}
 
-// Undo last move
-void undo()
-{
-    // Empty undo stack
-    if (undo_stack == NULL)
+    next = (next != -1) ? next : first;
+
+    // No other variation
+    if (next == -1)
     {
-        print_error(5, 0);
+        print_error(12, 0);
         return;
     }
 
-    // Push boards to redo stack
-    redo_stack = push(redo_stack, boards);
+    undo();
+    invalidate_checkpoints(last);
 
-    // Return to last move in undo stack
-    replace_with_top(undo_stack);
-    undo_stack = pop(undo_stack);
+    history[last] = NODE_PLY(*history_node(next));
+    history_line[last + 1] = next;
+    history_length = last + 1;
 
-    mark_boards();
+    extend_line();
+    redo();
 }
 
-// Redo last move
-void redo()
+/* GO TO MOVE */
+
+// Go to a move of shown variation chosen by user
+void go_to_move()
 {
-    // Empty redo stack
-    if (redo_stack == NULL)
+    char *move_number = input_prompt("Enter move number - Digits only", 1);
+
+    if (strlen(move_number) == 0 || !seek_move(strtol(move_number, NULL, 10)))
     {
-        print_error(6, 0);
-        return;
+        print_error(13, 1);
+        resize_or_quit(getch());
     }
+}
 
-    // Push boards to undo stack
-    undo_stack = push(undo_stack, boards);
+// Go to position after a number of user moves (& the plies following them) of shown variation
+// Returns 1: found, 0: variation doesn't have that many user moves
+int seek_move(long move_number)
+{
+    // Ply of the next user move
+    int ply = 0;
 
-    // Return to last move in redo stack
-    replace_with_top(redo_stack);
-    redo_stack = pop(redo_stack);
+    for (; ply < history_length; ply++)
+    {
+        if ((history[ply] & HUMAN_MOVE) && !move_number--)
+        {
+            break;
+        }
+    }
 
-    mark_boards();
+    if (move_number > 0)
+    {
+        return 0;
+    }
+
+    go_to_ply(ply);
+
+    return 1;
 }
 
-// Clear stacks
-void clear_stacks()
+// Go to a ply of shown variation -> boards set from a checkpoint, not by undoing / redoing
+void go_to_ply(int ply)
 {
-    clear_undo();
-    clear_redo();
+    position target = ply_position(ply);
+
+    boards_hash = hash_update(boards_hash, boards, target);
+    boards = target;
+
+    mark_boards(boards, dead_boards);
+
+    // Two players -> turn changes every ply
+    if (which_mode == 0 && (ply - history_cursor) % 2)
+    {
+        turn *= -1;
+    }
+
+    history_cursor = ply;
 }
 
-// Clear undo stack
-void clear_undo()
+// Find position after a number of plies of shown variation
+position ply_position(int ply)
 {
-    node *temp;
+    int checkpoint = ply / CHECKPOINT_PLIES;
 
-    // Delete all nodes
-    while (undo_stack != NULL)
+    // Missing checkpoints -> made from the ones before them
+    while (history_no_checkpoints <= checkpoint)
     {
-        temp = undo_stack;
-        undo_stack = undo_stack -> next;
+        position pos = history_checkpoints[history_no_checkpoints - 1];
+
+        for (int i = (history_no_checkpoints - 1) * CHECKPOINT_PLIES; i < history_no_checkpoints * CHECKPOINT_PLIES; i++)
+        {
+            pos |= MOVE_BIT(history[i] & PLY_MOVE);
+        }
 
-        free(temp);
+        history_checkpoints[history_no_checkpoints++] = pos;
     }
+
+    position pos = history_checkpoints[checkpoint];
+
+    for (int i = checkpoint * CHECKPOINT_PLIES; i < ply; i++)
+    {
+        pos |= MOVE_BIT(history[i] & PLY_MOVE);
+    }
+
+    return pos;
 }
 
-// Clear redo stack
-void clear_redo()
+// Drop checkpoints that depend on a ply of shown variation -> called before the ply changes
+void invalidate_checkpoints(int ply)
 {
-    node *temp;
+    int first_invalid = ply / CHECKPOINT_PLIES + 1;
 
-    // Delete all nodes
-    while (redo_stack != NULL)
+    if (history_no_checkpoints > first_invalid)
     {
-        temp = redo_stack;
-        redo_stack = redo_stack -> next;
-
-        free(temp);
+        history_no_checkpoints = first_invalid;
     }
 }
@@ -1,45 +1,48 @@
 #ifndef MOVES_H_INCLUDED
 #define MOVES_H_INCLUDED
 
+#include <stdint.h>
 #include <stdio.h>
 
-typedef struct node node;
+#include "position.h"
+#include "save.h"
 
 /* DEFINITIONS */
 #define NO_BOARDS 3 
 
 /* FUNCTIONS */
 void play_move(int x, int y);
+void apply_move(int move);
 
 int is_valid(int x, int y);
-int is_finished();
-
-void mark_boards();
-int is_dead(int board[3][3]);
 
 void save_game();
 char *file_name_prompt();
+char *input_prompt(char *message, int digits_only);
 int write_game_data(char *file_name);
-void write_node(node *node_to_write, FILE *game_file);
 
 int load_game();
-int check_game_data(FILE *game_file, int *number_of_nodes);
-void read_game_data(FILE *game_file, int number_of_nodes);
-void read_undo_stack(FILE *game_file, int number_of_nodes);
-
-node *create_node(int value[NO_BOARDS][3][3], node *next);
+void restore_game(saved_game *game);
 
-void init_stacks();
+void clear_history();
+void init_history(position base);
+void record_ply(int ply);
+void toggle_ply(int ply);
 
-node *push(node *head, int value[NO_BOARDS][3][3]);
-node *pop(node *head);
-void replace_with_top(node *head);
+int follow_ply(int ply);
+void extend_line();
+int find_child(int parent, int ply);
+int add_node(int parent, int ply);
+uint32_t *history_node(int index);
 
 void undo();
 void redo();
+void switch_variation();
 
-void clear_stacks();
-void clear_undo();
-void clear_redo();
+void go_to_move();
+int seek_move(long move_number);
+void go_to_ply(int ply);
+position ply_position(int ply);
+void invalidate_checkpoints(int ply);
 
 #endif
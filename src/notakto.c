@@ -1,10 +1,81 @@
 /* Curses initialization & game start */
 #include <ncurses.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
+#include "book.h"
+#include "engine.h"
 #include "main_scr.h"
+#include "protocol.h"
+#include "server.h"
+#include "tablebase.h"
 
-int main(void)
+int main(int argc, char *argv[])
 {
+    // Engine seed -> current time unless given with -s / --seed
+    uint64_t seed = time(NULL);
+    char *tablebase_file = NULL;
+    char *book_file = NULL;
+    int engine_mode = 0;
+    char *socket_path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((!strcmp(argv[i], "-s") || !strcmp(argv[i], "--seed")) && i + 1 < argc)
+        {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if ((!strcmp(argv[i], "-t") || !strcmp(argv[i], "--tablebase")) && i + 1 < argc)
+        {
+            tablebase_file = argv[++i];
+        }
+        else if ((!strcmp(argv[i], "-b") || !strcmp(argv[i], "--book")) && i + 1 < argc)
+        {
+            book_file = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-e") || !strcmp(argv[i], "--engine"))
+        {
+            engine_mode = 1;
+        }
+        else if (!strcmp(argv[i], "--server") && i + 1 < argc)
+        {
+            socket_path = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-s | --seed <number>] [-t | --tablebase <file>] [-b | --book <file>] [-e | --engine] [--server <socket>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Set up engine
+    engine eng;
+    init_engine(&eng, seed);
+
+    if (tablebase_file != NULL && !load_tablebase(&eng, tablebase_file))
+    {
+        fprintf(stderr, "%s: couldn't load tablebase %s\n", argv[0], tablebase_file);
+        return 1;
+    }
+
+    if (book_file != NULL && !load_book(&eng, book_file))
+    {
+        fprintf(stderr, "%s: couldn't load book %s\n", argv[0], book_file);
+        return 1;
+    }
+
+    // Headless engine -> positions from stdin or a Unix socket, moves back the same way
+    if (engine_mode || socket_path != NULL)
+    {
+        int failed = (socket_path != NULL) ? run_server(&eng, socket_path) : run_engine_mode(&eng, 0, 1);
+
+        unload_tablebase(&eng);
+        unload_book(&eng);
+
+        return failed;
+    }
+
     // Start curses mode
     initscr();
     refresh();
@@ -14,10 +85,13 @@ int main(void)
     keypad(stdscr, TRUE);
 
     // Initialize game
-    init_game();
+    init_game(&eng);
 
     // End curses mode
     endwin();
 
+    unload_tablebase(&eng);
+    unload_book(&eng);
+
     return 0;
 }
@@ -0,0 +1,19 @@
+#ifndef NOTAKTO_H_INCLUDED
+#define NOTAKTO_H_INCLUDED
+
+/* Public interface of libnotakto -> engine, tables, text protocol & save files without curses
+ * Programs linking libnotakto.a or libnotakto.so include only this header */
+#include "book.h"
+#include "engine.h"
+#include "hash.h"
+#include "position.h"
+#include "protocol.h"
+#include "save.h"
+#include "symmetry.h"
+#include "tablebase.h"
+
+/* DEFINITIONS */
+// Bumped whenever a declaration in the interface changes incompatibly
+#define NOTAKTO_API_VERSION 2
+
+#endif
@@ -0,0 +1,125 @@
+/* Check engine's position values against the exhaustive solver */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "engine.h"
+#include "position.h"
+#include "solver.h"
+#include "tablebase.h"
+
+/* DEFINITIONS */
+#define NO_CONFIGS      512
+#define MAX_MISMATCHES  10              // Mismatches to print
+
+/* FUNCTIONS */
+int find_reachable_boards(int reachable[NO_CONFIGS]);
+
+int main(int argc, char *argv[])
+{
+    // Tablebase to check as well (optional)
+    engine eng;
+    init_engine(&eng, 0);
+
+    if (argc == 3 && (!strcmp(argv[1], "-t") || !strcmp(argv[1], "--tablebase")))
+    {
+        if (!load_tablebase(&eng, argv[2]))
+        {
+            fprintf(stderr, "oracle: couldn't load tablebase %s\n", argv[2]);
+            return 1;
+        }
+    }
+    else if (argc != 1)
+    {
+        fprintf(stderr, "usage: %s [-t | --tablebase <file>]\n", argv[0]);
+        return 1;
+    }
+
+    clock_t start = clock();
+
+    // Every combination of reachable boards is a reachable position
+    int reachable[NO_CONFIGS];
+    int no_reachable = find_reachable_boards(reachable);
+
+    long no_positions = 0;
+    long mismatches = 0;
+
+    for (int i = 0; i < no_reachable; i++)
+    {
+        for (int j = 0; j < no_reachable; j++)
+        {
+            for (int k = 0; k < no_reachable; k++)
+            {
+                position pos = (position) reachable[i] | (position) reachable[j] << BOARD_BITS | (position) reachable[k] << (2 * BOARD_BITS);
+                no_positions++;
+
+                // Engine's P-positions are the ones the player to move loses
+                int pos_value = find_pos_value(pos);
+                if (is_winning(pos_value) == solve(pos, NULL))
+                {
+                    if (mismatches++ < MAX_MISMATCHES)
+                    {
+                        printf("mismatch: position %07o, value %s, solver: %s\n", pos, value_names[pos_value],
+                               solve(pos, NULL) ? "win" : "loss");
+                    }
+                }
+
+                // Tablebase result & distance
+                if (eng.tablebase != NULL)
+                {
+                    int distance, tablebase_distance;
+                    int wins = solve(pos, &distance);
+
+                    if (probe_tablebase(&eng, pos, &tablebase_distance) != wins || tablebase_distance != distance)
+                    {
+                        if (mismatches++ < MAX_MISMATCHES)
+                        {
+                            printf("mismatch: position %07o, tablebase: %s in %d, solver: %s in %d\n", pos,
+                                   probe_tablebase(&eng, pos, NULL) ? "win" : "loss", tablebase_distance,
+                                   wins ? "win" : "loss", distance);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("reachable boards    : %d\n", no_reachable);
+    printf("positions checked   : %ld\n", no_positions);
+    printf("canonical positions : %ld\n", solver_size());
+    printf("mismatches          : %ld\n", mismatches);
+    printf("time                : %.3f s\n", (double) (clock() - start) / CLOCKS_PER_SEC);
+
+    free_solver();
+    unload_tablebase(&eng);
+
+    return mismatches ? 1 : 0;
+}
+
+// Find boards reachable by playing on a single board
+// A board is reachable if it's alive or an X can be removed to leave it alive
+// Returns number of reachable boards
+int find_reachable_boards(int reachable[NO_CONFIGS])
+{
+    int counter = 0;
+
+    for (int i = 0; i < NO_CONFIGS; i++)
+    {
+        int is_reachable = !is_dead(i);
+
+        for (int j = 0; j < BOARD_BITS && !is_reachable; j++)
+        {
+            if ((i & (1 << j)) && !is_dead(i & ~(1 << j)))
+            {
+                is_reachable = 1;
+            }
+        }
+
+        if (is_reachable)
+        {
+            reachable[counter++] = i;
+        }
+    }
+
+    return counter;
+}
@@ -0,0 +1,108 @@
+/* Packed board & position representation */
+#include "position.h"
+
+/* DEFINITIONS */
+#define NO_LINES 8
+
+// Bit masks of all lines in a board -> 3 rows, 3 columns & 2 diagonals
+const int line_masks[NO_LINES] = {0007, 0070, 0700,              // Rows
+                                  0111, 0222, 0444,              // Columns
+                                  0421, 0124};                   // Diagonals
+
+/* FUNCTIONS */
+int is_finished(position pos, int dead_boards[NO_BOARDS]);
+void mark_boards(position pos, int dead_boards[NO_BOARDS]);
+int is_dead(int board);
+
+int compare_boards(int board1, int board2);
+void rotate_board(int board, int rotations[NO_ROTATIONS]);
+
+// Check if game is finished & mark dead boards
+// Returns 1: finished, 0: not
+int is_finished(position pos, int dead_boards[NO_BOARDS])
+{
+    // Mark dead boards
+    mark_boards(pos, dead_boards);
+
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        if (!dead_boards[i])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Mark dead boards of a position
+void mark_boards(position pos, int dead_boards[NO_BOARDS])
+{
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        dead_boards[i] = is_dead(GET_BOARD(pos, i));
+    }
+}
+
+// Check if a board is dead
+// Returns 1: if board has three Xs in a row, 0: otherwise
+int is_dead(int board)
+{
+    for (int i = 0; i < NO_LINES; i++)
+    {
+        if ((board & line_masks[i]) == line_masks[i])
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Compare two boards, including all rotations of the second
+// Returns 1: if the same, 0: otherwise
+int compare_boards(int board1, int board2)
+{
+    int rotations[NO_ROTATIONS];
+    rotate_board(board2, rotations);
+
+    for (int i = 0; i < NO_ROTATIONS; i++)
+    {
+        if (board1 == rotations[i])
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Produce all (8) possible rotations of a board configuration
+// Fills array with 8 boards
+void rotate_board(int board, int rotations[NO_ROTATIONS])
+{
+    for (int i = 0; i < NO_ROTATIONS; i++)
+    {
+        rotations[i] = 0;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            int bit = 1 << (i * 3 + j);
+
+            rotations[0] |= BOARD_CELL(board, i, j) ? bit : 0;
+            rotations[1] |= BOARD_CELL(board, i, 2 - j) ? bit : 0;
+
+            rotations[2] |= BOARD_CELL(board, j, i) ? bit : 0;
+            rotations[3] |= BOARD_CELL(board, j, 2 - i) ? bit : 0;
+
+            rotations[4] |= BOARD_CELL(board, 2 - i, j) ? bit : 0;
+            rotations[5] |= BOARD_CELL(board, 2 - i, 2 - j) ? bit : 0;
+
+            rotations[6] |= BOARD_CELL(board, 2 - j, i) ? bit : 0;
+            rotations[7] |= BOARD_CELL(board, 2 - j, 2 - i) ? bit : 0;
+        }
+    }
+}
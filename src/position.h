@@ -0,0 +1,37 @@
+#ifndef POSITION_H_INCLUDED
+#define POSITION_H_INCLUDED
+
+#include <stdint.h>
+
+/* DEFINITIONS */
+#define NO_BOARDS    3
+#define NO_ROTATIONS 8
+
+#define BOARD_BITS   9
+#define BOARD_MASK   0x1FF
+
+// Position -> all boards packed into one word
+// Board i occupies bits 9 * i to 9 * i + 8, cell (y, x) of a board is bit 3 * y + x
+// A set bit is an X, an unset bit is an empty space
+typedef uint32_t position;
+
+// Move index -> 9 * board + 3 * y + x, which is also its bit in a position
+#define MOVE_INDEX(which_board, y, x) ((which_board) * BOARD_BITS + (y) * 3 + (x))
+#define MOVE_BIT(move)                ((position) 1 << (move))
+
+// Single board (9-bit mask) of a position
+#define GET_BOARD(pos, which_board)   (((pos) >> ((which_board) * BOARD_BITS)) & BOARD_MASK)
+
+// Single cell of a board / of a position -> 1: X, 0: empty
+#define BOARD_CELL(board, y, x)       (((board) >> ((y) * 3 + (x))) & 1)
+#define GET_CELL(pos, which_board, y, x) (((pos) >> MOVE_INDEX(which_board, y, x)) & 1)
+
+/* FUNCTIONS */
+int is_finished(position pos, int dead_boards[NO_BOARDS]);
+void mark_boards(position pos, int dead_boards[NO_BOARDS]);
+int is_dead(int board);
+
+int compare_boards(int board1, int board2);
+void rotate_board(int board, int rotations[NO_ROTATIONS]);
+
+#endif
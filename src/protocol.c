@@ -0,0 +1,226 @@
+/* Text protocol -> one position per line in, one move & evaluation per line out */
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "engine.h"
+#include "position.h"
+#include "protocol.h"
+
+/* FUNCTIONS */
+int parse_position(const char *line, int length, position *pos);
+int write_reply(engine *eng, const char *line, int length, char *reply);
+
+void init_stream(line_stream *stream);
+int answer_stream(engine *eng, line_stream *stream);
+void finish_stream(engine *eng, line_stream *stream);
+
+int run_engine_mode(engine *eng, int in_fd, int out_fd);
+
+int write_all(int fd, const char *buffer, int length);
+
+// Read a position in text notation
+// length -> number of characters in line (without newline)
+// Returns 1: valid position, 0: otherwise
+int parse_position(const char *line, int length, position *pos)
+{
+    int cells = 0;
+    *pos = 0;
+
+    for (int i = 0; i < length; i++)
+    {
+        switch (line[i])
+        {
+            case 'X':
+            case 'x':
+                if (cells == POSITION_CELLS)
+                {
+                    return 0;
+                }
+                *pos |= MOVE_BIT(cells++);
+                break;
+            case '.':
+                if (cells == POSITION_CELLS)
+                {
+                    return 0;
+                }
+                cells++;
+                break;
+            case '/':
+            case '\r':
+                break;
+            default:
+                return 0;
+        }
+    }
+
+    return cells == POSITION_CELLS;
+}
+
+// Answer a request line -> "<move> <win | loss> <value>\n" for the player to move
+// move is a move index, "-" if the game is finished, invalid lines get "error\n"
+// Lines longer than MAX_LINE are invalid -> same reply however the line was split between reads
+// reply -> at least MAX_REPLY characters
+// Returns reply length
+int write_reply(engine *eng, const char *line, int length, char *reply)
+{
+    position pos;
+    if (length > MAX_LINE || !parse_position(line, length, &pos))
+    {
+        memcpy(reply, "error\n", 6);
+        return 6;
+    }
+
+    int pos_value = find_pos_value(pos);
+    int move = choose_move(eng, pos);
+
+    // Player to move loses in a P-position
+    const char *result = is_winning(pos_value) ? "loss" : "win";
+
+    if (move == -1)
+    {
+        return snprintf(reply, MAX_REPLY, "- %s %s\n", result, value_names[pos_value]);
+    }
+
+    return snprintf(reply, MAX_REPLY, "%d %s %s\n", move, result, value_names[pos_value]);
+}
+
+// Empty a stream
+void init_stream(line_stream *stream)
+{
+    stream -> in_length = 0;
+    stream -> skipping = 0;
+    stream -> out_length = 0;
+}
+
+// Answer every complete line of a stream's input -> replies are appended to its output
+// Stops early when output is full, unanswered lines stay at the start of input
+// Returns 1: output full (write it & call again before reading more), 0: all lines answered
+int answer_stream(engine *eng, line_stream *stream)
+{
+    int start = 0;
+    int full = 0;
+
+    for (int i = 0; i < stream -> in_length; i++)
+    {
+        if (stream -> in[i] != '\n')
+        {
+            continue;
+        }
+
+        if (stream -> out_length > STREAM_OUT - MAX_REPLY)
+        {
+            full = 1;
+            break;
+        }
+
+        if (stream -> skipping)
+        {
+            memcpy(stream -> out + stream -> out_length, "error\n", 6);
+            stream -> out_length += 6;
+            stream -> skipping = 0;
+        }
+        else
+        {
+            stream -> out_length += write_reply(eng, stream -> in + start, i - start, stream -> out + stream -> out_length);
+        }
+
+        start = i + 1;
+    }
+
+    // Keep unanswered input -> a partial line longer than MAX_LINE is answered with an error
+    stream -> in_length -= start;
+    memmove(stream -> in, stream -> in + start, stream -> in_length);
+
+    if (!full && stream -> in_length > MAX_LINE)
+    {
+        stream -> skipping = 1;
+        stream -> in_length = 0;
+    }
+
+    return full;
+}
+
+// Answer last line of a stream at end of input -> a line without a newline
+// Output must have room for one reply
+void finish_stream(engine *eng, line_stream *stream)
+{
+    if (stream -> skipping)
+    {
+        memcpy(stream -> out + stream -> out_length, "error\n", 6);
+        stream -> out_length += 6;
+    }
+    else if (stream -> in_length)
+    {
+        stream -> out_length += write_reply(eng, stream -> in, stream -> in_length, stream -> out + stream -> out_length);
+    }
+
+    stream -> in_length = 0;
+    stream -> skipping = 0;
+}
+
+// Answer positions read from in_fd until end of input
+// Replies are written in batches -> flushed before reading may block, so interactive use works too
+// Returns 0: end of input, 1: read or write error
+int run_engine_mode(engine *eng, int in_fd, int out_fd)
+{
+    static line_stream stream;
+    init_stream(&stream);
+
+    while (1)
+    {
+        // Answer & flush replies
+        int full;
+        do {
+            full = answer_stream(eng, &stream);
+
+            if (write_all(out_fd, stream.out, stream.out_length))
+            {
+                return 1;
+            }
+            stream.out_length = 0;
+        }while (full);
+
+        // Read more input
+        int got = read(in_fd, stream.in + stream.in_length, STREAM_IN - stream.in_length);
+        if (got == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            break;
+        }
+
+        stream.in_length += got;
+    }
+
+    finish_stream(eng, &stream);
+
+    return write_all(out_fd, stream.out, stream.out_length);
+}
+
+// Write whole buffer to a file descriptor
+// Returns 0: written, 1: error
+int write_all(int fd, const char *buffer, int length)
+{
+    while (length > 0)
+    {
+        int written = write(fd, buffer, length);
+
+        if (written == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return 1;
+        }
+
+        buffer += written;
+        length -= written;
+    }
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+#ifndef PROTOCOL_H_INCLUDED
+#define PROTOCOL_H_INCLUDED
+
+#include "engine.h"
+#include "position.h"
+
+/* DEFINITIONS */
+// Position notation -> 27 cells in move index order, 'X': X, '.': empty
+// '/' may separate boards, e.g. "X...X..../........./........."
+#define POSITION_CELLS 27
+
+#define MAX_LINE  128                   // Longest request line
+#define MAX_REPLY 32                    // Longest reply line
+
+#define STREAM_IN  16384
+#define STREAM_OUT 16384
+
+/* Request stream of one reader -> unanswered input & replies not written yet */
+typedef struct line_stream
+{
+    char in[STREAM_IN];
+    int in_length;
+    int skipping;                       // 1: rest of a too long line is being skipped
+
+    char out[STREAM_OUT];
+    int out_length;
+}line_stream;
+
+/* FUNCTIONS */
+int parse_position(const char *line, int length, position *pos);
+int write_reply(engine *eng, const char *line, int length, char *reply);
+
+void init_stream(line_stream *stream);
+int answer_stream(engine *eng, line_stream *stream);
+void finish_stream(engine *eng, line_stream *stream);
+
+int run_engine_mode(engine *eng, int in_fd, int out_fd);
+
+#endif
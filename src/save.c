@@ -0,0 +1,223 @@
+/* Versioned save format -> no curses, shared by the game & its checks */
+#include <string.h>
+
+#include "bytes.h"
+#include "position.h"
+#include "save.h"
+
+/* DEFINITIONS */
+#define CRC_POLYNOMIAL  0xEDB88320      // CRC-32, reflected
+
+/* FUNCTIONS */
+int encode_save(saved_game *game, unsigned char data[MAX_SAVE_SIZE]);
+int decode_save(unsigned char *data, int size, saved_game *game);
+int is_save(unsigned char *data, int size);
+int decode_old_save(unsigned char *data, int size, saved_game *game);
+position read_node(unsigned char *data);
+
+uint32_t find_crc(unsigned char *data, int size);
+
+// Encode a game as a save file
+// Returns file size
+int encode_save(saved_game *game, unsigned char data[MAX_SAVE_SIZE])
+{
+    memset(data, 0, MAX_SAVE_SIZE);
+    unsigned char *payload = data + SAVE_HEADER_SIZE;
+
+    uint32_t user_moves = 0;
+    for (int i = 0; i < game -> length; i++)
+    {
+        user_moves |= (uint32_t) ((game -> plies[i] & HUMAN_MOVE) != 0) << i;
+    }
+
+    payload[0] = game -> mode;
+    payload[1] = (game -> turn == -1) ? 0 : game -> turn;
+
+    write_uint32(payload + 2, game -> base);
+    write_uint32(payload + 6, user_moves);
+
+    payload[10] = game -> length;
+    payload[11] = game -> cursor;
+
+    // Plies -> bit j of a ply is bit (5 * ply + j) of the packed plies
+    for (int i = 0; i < game -> length; i++)
+    {
+        for (int j = 0; j < SAVE_PLY_BITS; j++)
+        {
+            int bit = i * SAVE_PLY_BITS + j;
+
+            payload[SAVE_FIXED_SIZE + bit / 8] |= (((game -> plies[i] & PLY_MOVE) >> j) & 1) << (bit % 8);
+        }
+    }
+
+    int payload_size = SAVE_FIXED_SIZE + (game -> length * SAVE_PLY_BITS + 7) / 8;
+
+    // Header
+    memcpy(data, SAVE_MAGIC, sizeof(SAVE_MAGIC));
+    write_uint32(data + 8, SAVE_VERSION);
+    write_uint32(data + 12, find_crc(payload, payload_size));
+
+    return SAVE_HEADER_SIZE + payload_size;
+}
+
+// Decode a save file -> version, size, CRC & every ply are checked
+// Returns 1: if save is correct, 0: if not
+int decode_save(unsigned char *data, int size, saved_game *game)
+{
+    unsigned char *payload = data + SAVE_HEADER_SIZE;
+    int payload_size = size - SAVE_HEADER_SIZE;
+
+    if (!is_save(data, size) || read_uint32(data + 8) != SAVE_VERSION || payload_size < SAVE_FIXED_SIZE ||
+        find_crc(payload, payload_size) != read_uint32(data + 12))
+    {
+        return 0;
+    }
+
+    position base = read_uint32(payload + 2);
+    uint32_t user_moves = read_uint32(payload + 6);
+
+    int length = payload[10];
+    int cursor = payload[11];
+
+    if (payload[0] > 1 || payload[1] > 1 || (base >> (NO_BOARDS * BOARD_BITS)) || length > MAX_PLIES || cursor > length ||
+        (user_moves >> length) || payload_size != SAVE_FIXED_SIZE + (length * SAVE_PLY_BITS + 7) / 8)
+    {
+        return 0;
+    }
+
+    // Plies -> every one must be legal after the ones before it
+    position pos = base;
+
+    for (int i = 0; i < length; i++)
+    {
+        int move = 0;
+
+        for (int j = 0; j < SAVE_PLY_BITS; j++)
+        {
+            int bit = i * SAVE_PLY_BITS + j;
+
+            move |= ((payload[SAVE_FIXED_SIZE + bit / 8] >> (bit % 8)) & 1) << j;
+        }
+
+        if (move >= NO_BOARDS * BOARD_BITS || (pos & MOVE_BIT(move)) || is_dead(GET_BOARD(pos, move / BOARD_BITS)))
+        {
+            return 0;
+        }
+
+        game -> plies[i] = move | (((user_moves >> i) & 1) ? HUMAN_MOVE : 0);
+        pos |= MOVE_BIT(move);
+    }
+
+    game -> mode = payload[0];
+    game -> turn = payload[1] ? payload[1] : -1;
+    game -> base = base;
+    game -> length = length;
+    game -> cursor = cursor;
+
+    return 1;
+}
+
+// Check if data starts with a save header -> older saves are one byte per cell (0 or 1)
+int is_save(unsigned char *data, int size)
+{
+    return size >= SAVE_HEADER_SIZE && !memcmp(data, SAVE_MAGIC, sizeof(SAVE_MAGIC));
+}
+
+// Decode a save from before the versioned format -> boards & a stack of undo snapshots
+// Snapshots become plies, the lowest new cell of every snapshot is the user's
+// Returns 1: if save is correct, 0: if not
+int decode_old_save(unsigned char *data, int size, saved_game *game)
+{
+    // Mode, turn, dead boards & boards at least, every byte 0 or 1
+    if (size < OLD_SAVE_FIXED_SIZE + OLD_SAVE_NODE_SIZE || (size - OLD_SAVE_FIXED_SIZE) % OLD_SAVE_NODE_SIZE)
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        if (data[i] > 1)
+        {
+            return 0;
+        }
+    }
+
+    position boards = read_node(data + OLD_SAVE_FIXED_SIZE);
+
+    // Undo snapshots -> latest first, only the latest MAX_PLIES are kept
+    int no_snapshots = (size - OLD_SAVE_FIXED_SIZE) / OLD_SAVE_NODE_SIZE - 1;
+    if (no_snapshots > MAX_PLIES)
+    {
+        no_snapshots = MAX_PLIES;
+    }
+
+    unsigned char *snapshots = data + OLD_SAVE_FIXED_SIZE + OLD_SAVE_NODE_SIZE;
+
+    game -> mode = data[0];
+    game -> turn = data[1] ? data[1] : -1;
+    game -> base = no_snapshots ? read_node(snapshots + (no_snapshots - 1) * OLD_SAVE_NODE_SIZE) : boards;
+    game -> length = 0;
+
+    for (int i = no_snapshots - 1; i >= 0; i--)
+    {
+        position from = read_node(snapshots + i * OLD_SAVE_NODE_SIZE);
+        position to = i ? read_node(snapshots + (i - 1) * OLD_SAVE_NODE_SIZE) : boards;
+
+        // Snapshots that don't follow each other -> history starts over
+        if (from & ~to)
+        {
+            game -> base = to;
+            game -> length = 0;
+            continue;
+        }
+
+        position added = to & ~from;
+        int flag = HUMAN_MOVE;
+
+        while (added)
+        {
+            game -> plies[game -> length++] = __builtin_ctz(added) | flag;
+
+            added &= added - 1;
+            flag = 0;
+        }
+    }
+
+    game -> cursor = game -> length;
+
+    return 1;
+}
+
+// Read a node of an old save -> byte i is cell of move index i
+position read_node(unsigned char *data)
+{
+    position value = 0;
+
+    for (int i = 0; i < OLD_SAVE_NODE_SIZE; i++)
+    {
+        if (data[i])
+        {
+            value |= MOVE_BIT(i);
+        }
+    }
+
+    return value;
+}
+
+// CRC-32 of data -> detects corrupted saves
+uint32_t find_crc(unsigned char *data, int size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (int i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+
+        for (int j = 0; j < 8; j++)
+        {
+            crc = (crc >> 1) ^ (CRC_POLYNOMIAL & -(crc & 1));
+        }
+    }
+
+    return ~crc;
+}
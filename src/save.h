@@ -0,0 +1,55 @@
+#ifndef SAVE_H_INCLUDED
+#define SAVE_H_INCLUDED
+
+#include <stdint.h>
+
+#include "position.h"
+
+/* DEFINITIONS */
+// Every ply fills a cell -> no game is longer than this
+#define MAX_PLIES   27
+
+// History entry -> one byte per ply
+#define HUMAN_MOVE  0x80                // Ply played by a user, undo & redo stop at these
+#define PLY_MOVE    0x1F                // Move index of the ply
+
+#define SAVE_MAGIC      "NOTAKSV"
+#define SAVE_VERSION    1
+
+// Header -> magic (8 bytes), version & CRC-32 of payload (4 bytes each)
+// Every number in a save is little endian, written a byte at a time
+#define SAVE_HEADER_SIZE 16
+
+// Payload -> mode, turn, base position (4 bytes), user moves mask (4 bytes), plies, played plies
+// followed by 5 bits per ply, least significant bit first
+#define SAVE_FIXED_SIZE 12
+#define SAVE_PLY_BITS   5
+#define MAX_PAYLOAD     (SAVE_FIXED_SIZE + (MAX_PLIES * SAVE_PLY_BITS + 7) / 8)
+
+#define MAX_SAVE_SIZE   (SAVE_HEADER_SIZE + MAX_PAYLOAD)
+
+// Saves before the versioned format -> one byte per cell (0 or 1)
+// Mode, turn & dead boards, then boards & undo snapshots (latest first), a node each
+#define OLD_SAVE_FIXED_SIZE 5
+#define OLD_SAVE_NODE_SIZE  (NO_BOARDS * BOARD_BITS)
+
+/* Saved game -> shown variation & how much of it is played */
+typedef struct saved_game
+{
+    int mode;
+    int turn;                           // 1: computer or player 1, -1: user or player 2
+    position base;                      // Position before the first ply
+    int length;                         // Plies of variation
+    int cursor;                         // Played plies
+    unsigned char plies[MAX_PLIES];     // History entries
+}saved_game;
+
+/* FUNCTIONS */
+int encode_save(saved_game *game, unsigned char data[MAX_SAVE_SIZE]);
+int decode_save(unsigned char *data, int size, saved_game *game);
+int is_save(unsigned char *data, int size);
+int decode_old_save(unsigned char *data, int size, saved_game *game);
+
+uint32_t find_crc(unsigned char *data, int size);
+
+#endif
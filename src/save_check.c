@@ -0,0 +1,242 @@
+/* Check save files -> round trip of random games, corrupted saves are rejected, old saves still load */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "position.h"
+#include "save.h"
+
+/* DEFINITIONS */
+#define NO_GAMES        10000
+#define MAX_FAILURES    10              // Failures to print
+
+#define OLD_SAVE_NODES  5               // Boards & 4 undo snapshots
+
+/* FUNCTIONS */
+long check_old_save();
+position read_cells(char *cells);
+void random_game(saved_game *game);
+int same_game(saved_game *a, saved_game *b);
+uint32_t next_random();
+
+uint32_t random_state = 2463534242u;
+
+// Old save -> mode, turn & dead boards, then boards & undo snapshots latest first, a cell per 0 or 1
+char *old_save[OLD_SAVE_NODES + 1] = {"10100",
+                                      "100010001 000010000 000010000",
+                                      "100010000 000010000 000010000",
+                                      "000010000 000010000 000000000",
+                                      "000000000 000000000 000000000",
+                                      "000000000 000000000 000000001"};
+
+// Plies it loads as -> lowest new cell of a snapshot is the user's
+// Oldest snapshot doesn't lead to the next one -> history starts from the empty boards
+unsigned char old_save_plies[] = {4 | HUMAN_MOVE, 13, 0 | HUMAN_MOVE, 22, 8 | HUMAN_MOVE};
+
+int main()
+{
+    clock_t start = clock();
+
+    long failures = 0;
+    long no_corrupted = 0;
+
+    for (int i = 0; i < NO_GAMES; i++)
+    {
+        saved_game game, loaded;
+        unsigned char data[MAX_SAVE_SIZE];
+
+        random_game(&game);
+        int size = encode_save(&game, data);
+
+        // Save & load -> same game, header numbers are little endian
+        if (!decode_save(data, size, &loaded) || !same_game(&game, &loaded) || data[8] != SAVE_VERSION ||
+            data[9] || data[10] || data[11])
+        {
+            if (failures++ < MAX_FAILURES)
+            {
+                printf("failure: game %d doesn't load back\n", i);
+            }
+        }
+
+        // Flip one bit of every byte -> magic, version or CRC must reject it
+        for (int j = 0; j < size; j++)
+        {
+            int bit = next_random() % 8;
+            no_corrupted++;
+
+            data[j] ^= 1 << bit;
+
+            if (decode_save(data, size, &loaded))
+            {
+                if (failures++ < MAX_FAILURES)
+                {
+                    printf("failure: game %d loads with bit %d of byte %d flipped\n", i, bit, j);
+                }
+            }
+
+            data[j] ^= 1 << bit;
+        }
+    }
+
+    failures += check_old_save();
+
+    printf("games checked       : %d\n", NO_GAMES);
+    printf("corrupted saves     : %ld\n", no_corrupted);
+    printf("failures            : %ld\n", failures);
+    printf("time                : %.3f s\n", (double) (clock() - start) / CLOCKS_PER_SEC);
+
+    return failures ? 1 : 0;
+}
+
+// Load the old save -> same game, undo steps back through its snapshots
+// Returns number of failures
+long check_old_save()
+{
+    unsigned char data[OLD_SAVE_FIXED_SIZE + (OLD_SAVE_NODES + 1) * OLD_SAVE_NODE_SIZE];
+    int size = 0;
+
+    for (int i = 0; i <= OLD_SAVE_NODES; i++)
+    {
+        for (char *cell = old_save[i]; *cell; cell++)
+        {
+            if (*cell != ' ')
+            {
+                data[size++] = *cell - '0';
+            }
+        }
+    }
+
+    saved_game game;
+    int length = sizeof(old_save_plies);
+
+    if (!decode_old_save(data, size, &game) || game.mode != 1 || game.turn != -1 || game.base != 0 ||
+        game.length != length || game.cursor != length || memcmp(game.plies, old_save_plies, length))
+    {
+        printf("failure: old save doesn't load\n");
+        return 1;
+    }
+
+    // Undo -> takes back plies up to & including a user's, leaves the next snapshot
+    long failures = 0;
+    position pos = game.base;
+    int snapshot = 1;
+
+    for (int i = 0; i < length; i++)
+    {
+        pos |= MOVE_BIT(game.plies[i] & PLY_MOVE);
+    }
+
+    if (pos != read_cells(old_save[1]))
+    {
+        printf("failure: old save's boards are %07o\n", pos);
+        failures++;
+    }
+
+    for (int i = length - 1; i >= 0; i--)
+    {
+        pos &= ~MOVE_BIT(game.plies[i] & PLY_MOVE);
+
+        if ((game.plies[i] & HUMAN_MOVE) && pos != read_cells(old_save[++snapshot]))
+        {
+            printf("failure: undo %d of old save leaves %07o\n", snapshot - 1, pos);
+            failures++;
+        }
+    }
+
+    // Wrong size or a byte other than 0 & 1 -> rejected
+    if (decode_old_save(data, size - 1, &game))
+    {
+        printf("failure: old save loads without its last byte\n");
+        failures++;
+    }
+
+    data[OLD_SAVE_FIXED_SIZE] = 2;
+
+    if (decode_old_save(data, size, &game))
+    {
+        printf("failure: old save loads with a cell of 2\n");
+        failures++;
+    }
+
+    return failures;
+}
+
+// Read cells of an old save node -> '1' is an X, spaces between boards
+position read_cells(char *cells)
+{
+    position pos = 0;
+    int move = 0;
+
+    for (; *cells; cells++)
+    {
+        if (*cells != ' ')
+        {
+            pos |= (position) (*cells - '0') << move++;
+        }
+    }
+
+    return pos;
+}
+
+// Random legal game -> random base, plies & cursor, any ply may be a user's
+void random_game(saved_game *game)
+{
+    position pos = 0;
+    int base_plies = next_random() % 6;
+
+    game -> mode = next_random() % 2;
+    game -> turn = (next_random() % 2) ? 1 : -1;
+    game -> base = 0;
+    game -> length = 0;
+
+    for (int i = 0; i < MAX_PLIES; i++)
+    {
+        int moves[NO_BOARDS * BOARD_BITS];
+        int no_moves = 0;
+
+        for (int move = 0; move < NO_BOARDS * BOARD_BITS; move++)
+        {
+            if (!(pos & MOVE_BIT(move)) && !is_dead(GET_BOARD(pos, move / BOARD_BITS)))
+            {
+                moves[no_moves++] = move;
+            }
+        }
+
+        if (no_moves == 0)
+        {
+            break;
+        }
+
+        int move = moves[next_random() % no_moves];
+        pos |= MOVE_BIT(move);
+
+        if (i < base_plies)
+        {
+            game -> base = pos;
+        }
+        else
+        {
+            game -> plies[game -> length++] = move | ((next_random() % 2) ? HUMAN_MOVE : 0);
+        }
+    }
+
+    game -> cursor = next_random() % (game -> length + 1);
+}
+
+// Compare games
+// Returns 1: if same, 0: if not
+int same_game(saved_game *a, saved_game *b)
+{
+    return a -> mode == b -> mode && a -> turn == b -> turn && a -> base == b -> base && a -> length == b -> length &&
+           a -> cursor == b -> cursor && !memcmp(a -> plies, b -> plies, a -> length);
+}
+
+// Xorshift -> fixed seed, same games on every run
+uint32_t next_random()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+
+    return random_state;
+}
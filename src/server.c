@@ -0,0 +1,326 @@
+/* Engine server -> text protocol over a Unix socket, many clients in one epoll loop */
+#define _GNU_SOURCE                     // accept4
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "engine.h"
+#include "protocol.h"
+#include "server.h"
+
+/* DEFINITIONS */
+#define MAX_EVENTS 64
+
+/* Connected client -> requests are pipelined, replies leave in request order */
+typedef struct client
+{
+    int fd;
+    int closing;                        // 1: input ended, close once output is written
+    line_stream stream;
+}client;
+
+volatile sig_atomic_t server_stopping = 0;
+
+/* FUNCTIONS */
+int run_server(engine *eng, char *socket_path);
+
+int open_socket(char *socket_path);
+int is_stale_socket(struct sockaddr_un *address);
+void accept_clients(int listen_fd, int epoll_fd);
+int serve_client(engine *eng, client *c);
+int flush_client(client *c);
+void close_client(client *c, int epoll_fd);
+
+void stop_server(int signal_number);
+
+// Answer clients connecting to a Unix socket until interrupted
+// Returns 0: stopped by a signal, 1: socket couldn't be set up or waiting for it failed
+int run_server(engine *eng, char *socket_path)
+{
+    int listen_fd = open_socket(socket_path);
+    if (listen_fd == -1)
+    {
+        return 1;
+    }
+
+    int epoll_fd = epoll_create1(0);
+    if (epoll_fd == -1)
+    {
+        close(listen_fd);
+        unlink(socket_path);
+        return 1;
+    }
+
+    // Listening socket has no client -> data pointer is NULL
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event) == -1)
+    {
+        perror("notakto: epoll_ctl");
+        close(epoll_fd);
+        close(listen_fd);
+        unlink(socket_path);
+        return 1;
+    }
+
+    // Stop cleanly on interrupt, closed clients are seen as write errors
+    signal(SIGINT, stop_server);
+    signal(SIGTERM, stop_server);
+    signal(SIGPIPE, SIG_IGN);
+
+    struct epoll_event events[MAX_EVENTS];
+    int failed = 0;
+
+    while (!server_stopping)
+    {
+        int no_events = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+
+        // Interrupted -> loop checks for a stop, any other error won't go away
+        if (no_events == -1 && errno != EINTR)
+        {
+            perror("notakto: epoll_wait");
+            failed = 1;
+            break;
+        }
+
+        for (int i = 0; i < no_events; i++)
+        {
+            client *c = (client *) events[i].data.ptr;
+
+            if (c == NULL)
+            {
+                accept_clients(listen_fd, epoll_fd);
+                continue;
+            }
+
+            // Wait for input if all output is written, otherwise wait until it can be -> back pressure
+            int waiting = serve_client(eng, c);
+
+            if (waiting == -1)
+            {
+                close_client(c, epoll_fd);
+            }
+            else
+            {
+                event.events = waiting;
+                event.data.ptr = c;
+                epoll_ctl(epoll_fd, EPOLL_CTL_MOD, c -> fd, &event);
+            }
+        }
+    }
+
+    close(epoll_fd);
+    close(listen_fd);
+    unlink(socket_path);
+
+    return failed;
+}
+
+// Create listening socket -> a stale socket file from an earlier server is replaced
+// Returns socket, -1 on error
+int open_socket(char *socket_path)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "notakto: socket path too long %s\n", socket_path);
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    // Socket file of a running server -> leave it alone
+    struct stat st;
+    if (stat(socket_path, &st) == 0 && S_ISSOCK(st.st_mode))
+    {
+        if (!is_stale_socket(&address))
+        {
+            fprintf(stderr, "notakto: socket %s is in use by another server\n", socket_path);
+            return -1;
+        }
+
+        unlink(socket_path);
+    }
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd == -1)
+    {
+        perror("notakto: socket");
+        return -1;
+    }
+
+    if (bind(listen_fd, (struct sockaddr *) &address, sizeof(address)) == -1 || listen(listen_fd, SOMAXCONN) == -1)
+    {
+        perror("notakto: bind");
+        close(listen_fd);
+        return -1;
+    }
+
+    return listen_fd;
+}
+
+// Check if nobody listens on a socket file -> connection is refused
+// Returns 1: stale, 0: in use or can't tell
+int is_stale_socket(struct sockaddr_un *address)
+{
+    int probe_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe_fd == -1)
+    {
+        return 0;
+    }
+
+    int stale = connect(probe_fd, (struct sockaddr *) address, sizeof(struct sockaddr_un)) == -1 && errno == ECONNREFUSED;
+    close(probe_fd);
+
+    return stale;
+}
+
+// Accept every pending connection
+void accept_clients(int listen_fd, int epoll_fd)
+{
+    int fd;
+    while ((fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) != -1)
+    {
+        client *c = (client *) malloc(sizeof(client));
+        if (c == NULL)
+        {
+            close(fd);
+            continue;
+        }
+
+        c -> fd = fd;
+        c -> closing = 0;
+        init_stream(&c -> stream);
+
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = c;
+
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1)
+        {
+            close(fd);
+            free(c);
+        }
+    }
+}
+
+// Answer a client's requests -> one read per wakeup so a busy client can't starve the others
+// Level triggered epoll reports the client again while it has input left
+// Returns epoll events to wait for, -1: client is done
+int serve_client(engine *eng, client *c)
+{
+    line_stream *stream = &c -> stream;
+    int has_read = 0;
+
+    while (1)
+    {
+        // Answer buffered requests & write replies
+        int full;
+        do {
+            full = answer_stream(eng, stream);
+
+            int flushed = flush_client(c);
+            if (flushed == -1)
+            {
+                return -1;
+            }
+            if (!flushed)
+            {
+                return EPOLLOUT;
+            }
+        }while (full);
+
+        if (c -> closing)
+        {
+            return -1;
+        }
+
+        if (has_read)
+        {
+            return EPOLLIN;
+        }
+
+        // Read more requests
+        int got = read(c -> fd, stream -> in + stream -> in_length, STREAM_IN - stream -> in_length);
+
+        if (got == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return EPOLLIN;
+        }
+
+        has_read = 1;
+
+        if (got <= 0)
+        {
+            // End of input -> answer last line, close after writing
+            finish_stream(eng, stream);
+            c -> closing = 1;
+            continue;
+        }
+
+        stream -> in_length += got;
+    }
+}
+
+// Write as much of a client's output as it takes
+// Returns 1: all written, 0: rest has to wait, -1: error
+int flush_client(client *c)
+{
+    line_stream *stream = &c -> stream;
+    int written = 0;
+
+    while (written < stream -> out_length)
+    {
+        int sent = write(c -> fd, stream -> out + written, stream -> out_length - written);
+
+        if (sent == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        if (sent <= 0)
+        {
+            return -1;
+        }
+
+        written += sent;
+    }
+
+    stream -> out_length -= written;
+    memmove(stream -> out, stream -> out + written, stream -> out_length);
+
+    return stream -> out_length == 0;
+}
+
+// Disconnect a client
+void close_client(client *c, int epoll_fd)
+{
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, c -> fd, NULL);
+    close(c -> fd);
+    free(c);
+}
+
+// Signal handler -> leave event loop
+void stop_server(int signal_number)
+{
+    (void) signal_number;
+    server_stopping = 1;
+}
@@ -0,0 +1,9 @@
+#ifndef SERVER_H_INCLUDED
+#define SERVER_H_INCLUDED
+
+#include "engine.h"
+
+/* FUNCTIONS */
+int run_server(engine *eng, char *socket_path);
+
+#endif
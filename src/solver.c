@@ -0,0 +1,125 @@
+/* Exhaustive minimax solver -> used to check the engine */
+#include <stdlib.h>
+
+#include "position.h"
+#include "symmetry.h"
+
+/* DEFINITIONS */
+#define DEAD_BOARD   BOARD_MASK          // All dead boards are reduced to a full board
+
+/* Transposition table entry -> result of a position key */
+typedef struct entry
+{
+    unsigned char solved;               // 1: entry holds a result
+    unsigned char wins;                 // 1: player to move wins, 0: loses
+    unsigned char distance;             // Moves left until the game ends under best play
+}entry;
+
+// Indexed directly by position key -> no hashing or probing
+entry *table = NULL;
+long table_entries = 0;
+
+/* FUNCTIONS */
+int solve(position pos, int *distance);
+
+long solver_size();
+void free_solver();
+
+// Solve a position by searching all moves
+// distance -> filled with number of moves until the game ends (if not NULL)
+// Returns 1: player to move wins, 0: player to move loses
+int solve(position pos, int *distance)
+{
+    if (table == NULL)
+    {
+        table = (entry *) calloc(NO_POSITION_KEYS, sizeof(entry));
+        table_entries = 0;
+    }
+
+    // Look up position key
+    entry *found = &table[position_key(pos)];
+
+    if (found -> solved)
+    {
+        if (distance != NULL)
+        {
+            *distance = found -> distance;
+        }
+
+        return found -> wins;
+    }
+
+    // Search moves of canonical position -> dead boards are reduced to full boards
+    position canonical = canonical_position(pos);
+
+    // Player to move after the last board dies wins
+    int wins = 1;
+    int best_distance = 0;
+    int first_move = 1;
+
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        int board = GET_BOARD(canonical, i);
+
+        if (board == DEAD_BOARD)
+        {
+            continue;
+        }
+
+        for (int j = 0; j < BOARD_BITS; j++)
+        {
+            if (board & (1 << j))
+            {
+                continue;
+            }
+
+            int child_distance;
+            int child_wins = solve(canonical | MOVE_BIT(i * BOARD_BITS + j), &child_distance);
+
+            // Winner ends the game quickly, loser delays the end
+            if (first_move)
+            {
+                wins = !child_wins;
+                best_distance = child_distance + 1;
+                first_move = 0;
+            }
+            else if (!child_wins && (!wins || child_distance + 1 < best_distance))
+            {
+                wins = 1;
+                best_distance = child_distance + 1;
+            }
+            else if (!wins && child_distance + 1 > best_distance)
+            {
+                best_distance = child_distance + 1;
+            }
+        }
+    }
+
+    // Store result
+    found -> solved = 1;
+    found -> wins = wins;
+    found -> distance = best_distance;
+    table_entries++;
+
+    if (distance != NULL)
+    {
+        *distance = best_distance;
+    }
+
+    return wins;
+}
+
+// Number of position keys solved
+long solver_size()
+{
+    return table_entries;
+}
+
+// Free transposition table
+void free_solver()
+{
+    free(table);
+
+    table = NULL;
+    table_entries = 0;
+}
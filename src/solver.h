@@ -0,0 +1,12 @@
+#ifndef SOLVER_H_INCLUDED
+#define SOLVER_H_INCLUDED
+
+#include "position.h"
+
+/* FUNCTIONS */
+int solve(position pos, int *distance);
+
+long solver_size();
+void free_solver();
+
+#endif
@@ -0,0 +1,131 @@
+/* Symmetry reduction of boards & positions */
+#include "position.h"
+#include "symmetry.h"
+
+/* DEFINITIONS */
+#define NO_CONFIGS 512
+
+// Symmetry tables -> generated by gen_values.c
+// Dead boards can't be played on so they are all reduced to the full board
+extern const int canonical_boards[NO_CONFIGS];
+extern const int board_ids[NO_CONFIGS];
+extern const int id_boards[NO_CANONICAL_BOARDS];
+extern const int canonical_rotations[NO_CONFIGS];
+extern const int rotation_cells[NO_ROTATIONS][BOARD_BITS];
+
+/* FUNCTIONS */
+int canonical_board(int board);
+position canonical_position(position pos);
+
+int position_key(position pos);
+position key_position(int key);
+
+int key_order(position pos, int order[NO_BOARDS]);
+int key_move(position pos, int order[NO_BOARDS], int canonical_move);
+
+void sort_boards(int boards[NO_BOARDS]);
+
+// Find canonical form of a board -> smallest of its 8 rotations
+int canonical_board(int board)
+{
+    return canonical_boards[board];
+}
+
+// Find canonical form of a position
+// Every board is replaced by its canonical form & boards are sorted
+// Positions equal up to rotating boards & reordering them have the same canonical form
+position canonical_position(position pos)
+{
+    int boards[NO_BOARDS];
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        boards[i] = canonical_boards[GET_BOARD(pos, i)];
+    }
+
+    sort_boards(boards);
+
+    return (position) boards[0] | (position) boards[1] << BOARD_BITS | (position) boards[2] << (2 * BOARD_BITS);
+}
+
+// Find compact key of a position -> 0 to NO_POSITION_KEYS - 1
+// Boards are replaced by canonical ids & sorted, key of the sorted ids a <= b <= c is
+// C(c + 2, 3) + C(b + 1, 2) + a
+int position_key(position pos)
+{
+    int ids[NO_BOARDS];
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        ids[i] = board_ids[GET_BOARD(pos, i)];
+    }
+
+    sort_boards(ids);
+
+    return ids[2] * (ids[2] + 1) * (ids[2] + 2) / 6 + ids[1] * (ids[1] + 1) / 2 + ids[0];
+}
+
+// Find canonical position of a key
+position key_position(int key)
+{
+    int a, b, c;
+
+    for (c = 0; (c + 1) * (c + 2) * (c + 3) / 6 <= key; c++);
+    key -= c * (c + 1) * (c + 2) / 6;
+
+    for (b = 0; (b + 1) * (b + 2) / 2 <= key; b++);
+    key -= b * (b + 1) / 2;
+
+    a = key;
+
+    return (position) id_boards[a] | (position) id_boards[b] << BOARD_BITS | (position) id_boards[c] << (2 * BOARD_BITS);
+}
+
+// Find key of a position & which of its boards is at each board of key_position(key)
+// order -> filled with board index of every sorted id
+int key_order(position pos, int order[NO_BOARDS])
+{
+    int ids[NO_BOARDS];
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        ids[i] = board_ids[GET_BOARD(pos, i)];
+        order[i] = i;
+
+        // Insertion sort -> board indices move with their ids
+        for (int j = i; j > 0 && ids[j] < ids[j - 1]; j--)
+        {
+            int temp = ids[j]; ids[j] = ids[j - 1]; ids[j - 1] = temp;
+            temp = order[j]; order[j] = order[j - 1]; order[j - 1] = temp;
+        }
+    }
+
+    return ids[2] * (ids[2] + 1) * (ids[2] + 2) / 6 + ids[1] * (ids[1] + 1) / 2 + ids[0];
+}
+
+// Map a move of key_position(key) back to the position the key was found from
+// order -> filled by key_order
+// Returns move index in position
+int key_move(position pos, int order[NO_BOARDS], int canonical_move)
+{
+    int which_board = order[canonical_move / BOARD_BITS];
+    int rotation = canonical_rotations[GET_BOARD(pos, which_board)];
+
+    return which_board * BOARD_BITS + rotation_cells[rotation][canonical_move % BOARD_BITS];
+}
+
+// Sort 3 boards (or ids) in increasing order
+void sort_boards(int boards[NO_BOARDS])
+{
+    int temp;
+
+    if (boards[0] > boards[1])
+    {
+        temp = boards[0]; boards[0] = boards[1]; boards[1] = temp;
+    }
+    if (boards[1] > boards[2])
+    {
+        temp = boards[1]; boards[1] = boards[2]; boards[2] = temp;
+    }
+    if (boards[0] > boards[1])
+    {
+        temp = boards[0]; boards[0] = boards[1]; boards[1] = temp;
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef SYMMETRY_H_INCLUDED
+#define SYMMETRY_H_INCLUDED
+
+#include "position.h"
+
+/* DEFINITIONS */
+#define NO_CANONICAL_BOARDS 47          // 46 alive boards up to rotation + dead board
+#define NO_POSITION_KEYS    18424       // Multisets of 3 canonical boards
+
+/* FUNCTIONS */
+int canonical_board(int board);
+position canonical_position(position pos);
+
+int position_key(position pos);
+position key_position(int key);
+
+int key_order(position pos, int order[NO_BOARDS]);
+int key_move(position pos, int order[NO_BOARDS], int canonical_move);
+
+#endif
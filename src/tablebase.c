@@ -0,0 +1,154 @@
+/* Perfect play tablebase -> memory mapped file of all positions */
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bytes.h"
+#include "engine.h"
+#include "position.h"
+#include "symmetry.h"
+#include "tablebase.h"
+
+/* FUNCTIONS */
+void write_tablebase_header(unsigned char header[TABLEBASE_HEADER_SIZE]);
+int load_tablebase(engine *eng, char *file_name);
+void unload_tablebase(engine *eng);
+
+int probe_tablebase(engine *eng, position pos, int *distance);
+int tablebase_move(engine *eng, position pos);
+
+// Encode header of a tablebase file
+void write_tablebase_header(unsigned char header[TABLEBASE_HEADER_SIZE])
+{
+    memset(header, 0, TABLEBASE_HEADER_SIZE);
+
+    memcpy(header, TABLEBASE_MAGIC, sizeof(TABLEBASE_MAGIC));
+    write_uint32(header + 8, TABLEBASE_VERSION);
+    write_uint32(header + 12, TABLEBASE_ENTRIES);
+}
+
+// Map a tablebase file into memory & use it in engine
+// Returns 1: loaded, 0: file missing or invalid
+int load_tablebase(engine *eng, char *file_name)
+{
+    int fd = open(file_name, O_RDONLY);
+    if (fd == -1)
+    {
+        return 0;
+    }
+
+    // Check file size
+    struct stat st;
+    size_t size = TABLEBASE_HEADER_SIZE + TABLEBASE_ENTRIES;
+
+    if (fstat(fd, &st) == -1 || (size_t) st.st_size != size)
+    {
+        close(fd);
+        return 0;
+    }
+
+    // Pages are shared with every process using the same file
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        return 0;
+    }
+
+    // Check header
+    const unsigned char *header = (const unsigned char *) map;
+    if (memcmp(header, TABLEBASE_MAGIC, sizeof(TABLEBASE_MAGIC)) ||
+        read_uint32(header + 8) != TABLEBASE_VERSION || read_uint32(header + 12) != TABLEBASE_ENTRIES)
+    {
+        munmap(map, size);
+        return 0;
+    }
+
+    unload_tablebase(eng);
+
+    eng -> tablebase = (const unsigned char *) map;
+    eng -> tablebase_size = size;
+
+    return 1;
+}
+
+// Unmap engine's tablebase -> engine returns to quotient tables
+void unload_tablebase(engine *eng)
+{
+    if (eng -> tablebase != NULL)
+    {
+        munmap((void *) eng -> tablebase, eng -> tablebase_size);
+    }
+
+    eng -> tablebase = NULL;
+    eng -> tablebase_size = 0;
+}
+
+// Look up a position in engine's tablebase
+// distance -> filled with number of moves until the game ends (if not NULL)
+// Returns 1: player to move wins, 0: player to move loses
+int probe_tablebase(engine *eng, position pos, int *distance)
+{
+    unsigned char entry = eng -> tablebase[TABLEBASE_HEADER_SIZE + position_key(pos)];
+
+    if (distance != NULL)
+    {
+        *distance = entry & ENTRY_DISTANCE;
+    }
+
+    return (entry & ENTRY_WINS) ? 1 : 0;
+}
+
+// Choose move using engine's tablebase -> one lookup per move
+// Wins as fast as possible, otherwise delays the loss, ties are broken randomly
+// Returns move index, -1 if the game is finished
+int tablebase_move(engine *eng, position pos)
+{
+    int best_move = -1;
+    int best_wins = 0;
+    int best_distance = 0;
+    int ties = 0;
+
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        int board = GET_BOARD(pos, i);
+
+        if (is_dead(board))
+        {
+            continue;
+        }
+
+        for (int j = 0; j < BOARD_BITS; j++)
+        {
+            if (board & (1 << j))
+            {
+                continue;
+            }
+
+            int move = i * BOARD_BITS + j;
+            int distance;
+            int wins = !probe_tablebase(eng, pos | MOVE_BIT(move), &distance);
+
+            // Better move
+            if (best_move == -1 || (wins && !best_wins) ||
+                (wins && distance < best_distance) || (!wins && !best_wins && distance > best_distance))
+            {
+                best_move = move;
+                best_wins = wins;
+                best_distance = distance;
+                ties = 1;
+            }
+            // Equally good move
+            else if (wins == best_wins && distance == best_distance && !(engine_random(eng) % ++ties))
+            {
+                best_move = move;
+            }
+        }
+    }
+
+    return best_move;
+}
@@ -0,0 +1,32 @@
+#ifndef TABLEBASE_H_INCLUDED
+#define TABLEBASE_H_INCLUDED
+
+#include <stdint.h>
+
+#include "engine.h"
+#include "position.h"
+#include "symmetry.h"
+
+/* DEFINITIONS */
+#define TABLEBASE_MAGIC   "NOTAKTB"
+#define TABLEBASE_VERSION 1
+
+#define TABLEBASE_ENTRIES NO_POSITION_KEYS
+
+// Entry -> bit 7: player to move wins, bits 0 - 6: moves until the game ends
+#define ENTRY_WINS      0x80
+#define ENTRY_DISTANCE  0x7F
+
+// Header -> magic (8 bytes), version & number of entries (4 bytes each), followed by one byte per entry
+// Numbers are little endian, written a byte at a time
+#define TABLEBASE_HEADER_SIZE 16
+
+/* FUNCTIONS */
+void write_tablebase_header(unsigned char header[TABLEBASE_HEADER_SIZE]);
+int load_tablebase(engine *eng, char *file_name);
+void unload_tablebase(engine *eng);
+
+int probe_tablebase(engine *eng, position pos, int *distance);
+int tablebase_move(engine *eng, position pos);
+
+#endif
@@ -0,0 +1,30 @@
+/* Helpers shared by the headless tools -> timing & options */
+#include <string.h>
+#include <time.h>
+
+#include "tools.h"
+
+/* FUNCTIONS */
+long now_ns();
+char *option_value(int argc, char *argv[], int *i, char *short_name, char *long_name);
+
+// Monotonic time in nanoseconds
+long now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+// Read value of an option -> argv[*i] is the option's short or long name, value follows it
+// Returns value & moves *i past it, NULL: if not this option or value is missing
+char *option_value(int argc, char *argv[], int *i, char *short_name, char *long_name)
+{
+    if ((strcmp(argv[*i], short_name) && strcmp(argv[*i], long_name)) || *i + 1 >= argc)
+    {
+        return NULL;
+    }
+
+    return argv[++*i];
+}
@@ -0,0 +1,8 @@
+#ifndef TOOLS_H_INCLUDED
+#define TOOLS_H_INCLUDED
+
+/* FUNCTIONS */
+long now_ns();
+char *option_value(int argc, char *argv[], int *i, char *short_name, char *long_name);
+
+#endif
@@ -0,0 +1,460 @@
+/* Parallel engine vs engine tournament */
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "book.h"
+#include "engine.h"
+#include "position.h"
+#include "tablebase.h"
+#include "tools.h"
+
+/* DEFINITIONS */
+#define DEFAULT_GAMES   1000000
+#define DEFAULT_SEED    1
+
+#define MAX_CONFIGS     16
+#define MAX_THREADS     256
+#define CHUNK_GAMES     4096            // Games a thread claims at once -> counters are flushed per chunk
+
+#define ELO_ITERATIONS  1000
+#define PRIOR_WINS      0.5             // Pseudo wins per pair -> finite ratings for unbeaten configs
+
+/* Engine configuration taking part in the tournament */
+typedef struct config
+{
+    char *name;
+    int random;                         // 1: random legal moves, no engine
+    engine eng;                         // Tables shared by all threads -> read only
+}config;
+
+/* Tournament results -> shared by all threads, updated with atomic adds only
+ * Same counters as the stats screen, engine_games is kept per config as every config is a computer */
+typedef struct standings
+{
+    atomic_long engine_games[MAX_CONFIGS][2];           // 0: wins,      1: loses
+    atomic_long two_user_games[2];                      // 0: p 1 wins,  1: p 2 wins
+    atomic_long pair_wins[MAX_CONFIGS][MAX_CONFIGS];    // Breakdown of engine_games by opponent -> Elo
+    atomic_long moves;                                  // Throughput only
+}standings;
+
+/* Per-thread game state */
+typedef struct player_thread
+{
+    pthread_t thread;
+    uint64_t seed;
+    engine engines[MAX_CONFIGS];        // Own copies -> own random streams
+}player_thread;
+
+/* FUNCTIONS */
+int parse_config(config *conf, char *spec);
+void *run_thread(void *arg);
+int play_game(player_thread *player, int first, int second, long *moves);
+int random_move(engine *eng, position pos);
+void find_elo(double elo[MAX_CONFIGS]);
+void print_standings(double seconds);
+
+config configs[MAX_CONFIGS];
+int no_configs;
+
+long no_games = DEFAULT_GAMES;
+int no_pairs;
+atomic_long next_game;                  // First game of the next unclaimed chunk
+atomic_int stopping;                    // 1: threads stop after their current chunk
+
+standings results;
+
+int main(int argc, char *argv[])
+{
+    uint64_t seed = DEFAULT_SEED;
+    long no_threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // Read options
+    char *value;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((value = option_value(argc, argv, &i, "-g", "--games")) != NULL)
+        {
+            no_games = strtol(value, NULL, 10);
+        }
+        else if ((value = option_value(argc, argv, &i, "-s", "--seed")) != NULL)
+        {
+            seed = strtoull(value, NULL, 10);
+        }
+        else if ((value = option_value(argc, argv, &i, "-j", "--threads")) != NULL)
+        {
+            no_threads = strtol(value, NULL, 10);
+        }
+        else if (no_configs < MAX_CONFIGS && (value = option_value(argc, argv, &i, "-c", "--config")) != NULL)
+        {
+            if (!parse_config(&configs[no_configs++], value))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-g | --games <number>] [-s | --seed <number>] [-j | --threads <number>] "
+                            "[-c | --config random | quotient | book=<file>[,tablebase=<file>] | tablebase=<file>]...\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Default -> quotient engine vs random mover
+    if (!no_configs)
+    {
+        parse_config(&configs[no_configs++], "quotient");
+        parse_config(&configs[no_configs++], "random");
+    }
+
+    if (no_configs < 2)
+    {
+        fprintf(stderr, "tournament: at least two configurations are needed\n");
+        return 1;
+    }
+
+    no_threads = (no_threads < 1) ? 1 : (no_threads > MAX_THREADS) ? MAX_THREADS : no_threads;
+    no_pairs = no_configs * (no_configs - 1) / 2;
+
+    player_thread *players = (player_thread *) calloc(no_threads, sizeof(player_thread));
+
+    if (players == NULL)
+    {
+        fprintf(stderr, "tournament: out of memory\n");
+        return 1;
+    }
+
+    long start = now_ns();
+
+    for (int i = 0; i < no_threads; i++)
+    {
+        players[i].seed = seed;
+
+        // Not started -> threads already running stop before the results are dropped
+        if (pthread_create(&players[i].thread, NULL, run_thread, &players[i]))
+        {
+            fprintf(stderr, "tournament: couldn't start thread %d\n", i);
+            atomic_store(&stopping, 1);
+
+            for (int j = 0; j < i; j++)
+            {
+                pthread_join(players[j].thread, NULL);
+            }
+
+            free(players);
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < no_threads; i++)
+    {
+        pthread_join(players[i].thread, NULL);
+    }
+
+    print_standings((now_ns() - start) / 1e9);
+
+    free(players);
+
+    for (int i = 0; i < no_configs; i++)
+    {
+        unload_tablebase(&configs[i].eng);
+        unload_book(&configs[i].eng);
+    }
+
+    return 0;
+}
+
+// Read a configuration -> comma separated random, quotient, book=<file>, tablebase=<file>
+// Returns 1 if loaded, 0 otherwise
+int parse_config(config *conf, char *spec)
+{
+    conf -> name = spec;
+    conf -> random = 0;
+    init_engine(&conf -> eng, 0);
+
+    char *copy = strdup(spec);
+    if (copy == NULL)
+    {
+        fprintf(stderr, "tournament: out of memory\n");
+        return 0;
+    }
+
+    int loaded = 1;
+    char *saveptr;
+
+    for (char *option = strtok_r(copy, ",", &saveptr); option != NULL && loaded; option = strtok_r(NULL, ",", &saveptr))
+    {
+        if (!strcmp(option, "random"))
+        {
+            conf -> random = 1;
+        }
+        else if (!strcmp(option, "quotient"))
+        {
+            continue;
+        }
+        else if (!strncmp(option, "book=", 5))
+        {
+            loaded = load_book(&conf -> eng, option + 5);
+        }
+        else if (!strncmp(option, "tablebase=", 10))
+        {
+            loaded = load_tablebase(&conf -> eng, option + 10);
+        }
+        else
+        {
+            loaded = 0;
+        }
+    }
+
+    if (!loaded)
+    {
+        fprintf(stderr, "tournament: couldn't load configuration %s\n", spec);
+    }
+
+    free(copy);
+    return loaded;
+}
+
+// Play chunks of games until all games are claimed or tournament is stopping
+// Results are kept per thread & added to the shared standings once per chunk
+void *run_thread(void *arg)
+{
+    player_thread *player = (player_thread *) arg;
+
+    // Own copy of every config -> random streams are seeded per chunk
+    for (int i = 0; i < no_configs; i++)
+    {
+        player -> engines[i] = configs[i].eng;
+    }
+
+    // Game index -> pair of configs, who moves first alternates between rounds
+    int pair_configs[MAX_CONFIGS * MAX_CONFIGS][2];
+    for (int i = 0, pair = 0; i < no_configs; i++)
+    {
+        for (int j = i + 1; j < no_configs; j++, pair++)
+        {
+            pair_configs[pair][0] = i;
+            pair_configs[pair][1] = j;
+        }
+    }
+
+    long first;
+    while (!atomic_load(&stopping) && (first = atomic_fetch_add_explicit(&next_game, CHUNK_GAMES, memory_order_relaxed)) < no_games)
+    {
+        long last = (first + CHUNK_GAMES < no_games) ? first + CHUNK_GAMES : no_games;
+
+        // Streams depend on seed & chunk only -> same results for any number of threads
+        for (int i = 0; i < no_configs; i++)
+        {
+            seed_engine(&player -> engines[i], (player -> seed << 32) + (uint64_t) (first / CHUNK_GAMES) * MAX_CONFIGS + i);
+        }
+
+        long pair_wins[MAX_CONFIGS][MAX_CONFIGS] = {{0}};
+        long first_wins = 0;
+        long moves = 0;
+
+        for (long game = first; game < last; game++)
+        {
+            int pair = game % no_pairs;
+            int swap = (game / no_pairs) & 1;
+
+            int first_config  = pair_configs[pair][swap];
+            int second_config = pair_configs[pair][!swap];
+
+            if (play_game(player, first_config, second_config, &moves))
+            {
+                pair_wins[first_config][second_config]++;
+                first_wins++;
+            }
+            else
+            {
+                pair_wins[second_config][first_config]++;
+            }
+        }
+
+        // Flush chunk results
+        for (int i = 0; i < no_configs; i++)
+        {
+            for (int j = 0; j < no_configs; j++)
+            {
+                if (pair_wins[i][j])
+                {
+                    atomic_fetch_add_explicit(&results.pair_wins[i][j], pair_wins[i][j], memory_order_relaxed);
+                    atomic_fetch_add_explicit(&results.engine_games[i][0], pair_wins[i][j], memory_order_relaxed);
+                    atomic_fetch_add_explicit(&results.engine_games[j][1], pair_wins[i][j], memory_order_relaxed);
+                }
+            }
+        }
+
+        atomic_fetch_add_explicit(&results.two_user_games[0], first_wins, memory_order_relaxed);
+        atomic_fetch_add_explicit(&results.two_user_games[1], (last - first) - first_wins, memory_order_relaxed);
+        atomic_fetch_add_explicit(&results.moves, moves, memory_order_relaxed);
+    }
+
+    return NULL;
+}
+
+// Play one game between two configs
+// Returns 1 if first player won, 0 otherwise
+int play_game(player_thread *player, int first, int second, long *moves)
+{
+    int dead_boards[NO_BOARDS];
+    int players[2] = {first, second};
+
+    position pos = 0;
+    int turn = 0;
+
+    while (!is_finished(pos, dead_boards))
+    {
+        int current = players[turn];
+        engine *eng = &player -> engines[current];
+
+        int move = configs[current].random ? random_move(eng, pos) : choose_move(eng, pos);
+
+        pos |= MOVE_BIT(move);
+        (*moves)++;
+        turn = !turn;
+    }
+
+    // Player to move after the last board died wins
+    return turn == 0;
+}
+
+// Choose a random legal move -> baseline config
+int random_move(engine *eng, position pos)
+{
+    int empty[NO_BOARDS];
+    int legal_counter = 0;
+
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        int board = GET_BOARD(pos, i);
+
+        empty[i] = is_dead(board) ? 0 : ~board & BOARD_MASK;
+        legal_counter += __builtin_popcount(empty[i]);
+    }
+
+    if (!legal_counter)
+    {
+        return -1;
+    }
+
+    int rand_choice = engine_random(eng) % legal_counter;
+
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        int count = __builtin_popcount(empty[i]);
+
+        if (rand_choice >= count)
+        {
+            rand_choice -= count;
+            continue;
+        }
+
+        while (rand_choice--)
+        {
+            empty[i] &= empty[i] - 1;
+        }
+
+        return i * BOARD_BITS + __builtin_ctz(empty[i]);
+    }
+
+    return -1;
+}
+
+// Estimate Elo ratings from pair results -> Bradley-Terry model, MM iterations
+// Ratings are relative to the first config
+void find_elo(double elo[MAX_CONFIGS])
+{
+    double strength[MAX_CONFIGS];
+    double wins[MAX_CONFIGS][MAX_CONFIGS];
+
+    for (int i = 0; i < no_configs; i++)
+    {
+        strength[i] = 1;
+
+        for (int j = 0; j < no_configs; j++)
+        {
+            wins[i][j] = (i == j) ? 0 : atomic_load(&results.pair_wins[i][j]) + PRIOR_WINS;
+        }
+    }
+
+    for (int iteration = 0; iteration < ELO_ITERATIONS; iteration++)
+    {
+        for (int i = 0; i < no_configs; i++)
+        {
+            double total_wins = 0, weights = 0;
+
+            for (int j = 0; j < no_configs; j++)
+            {
+                if (i != j)
+                {
+                    total_wins += wins[i][j];
+                    weights += (wins[i][j] + wins[j][i]) / (strength[i] + strength[j]);
+                }
+            }
+
+            strength[i] = total_wins / weights;
+        }
+
+        // Keep first config at strength 1
+        for (int i = no_configs - 1; i >= 0; i--)
+        {
+            strength[i] /= strength[0];
+        }
+    }
+
+    for (int i = 0; i < no_configs; i++)
+    {
+        elo[i] = 400 * log10(strength[i]);
+    }
+}
+
+// Print tournament results
+void print_standings(double seconds)
+{
+    double elo[MAX_CONFIGS];
+    find_elo(elo);
+
+    // Same layout as the stats screen -> players 1 & 2 are whichever configs move first & second
+    long two_user_games[2] = {atomic_load(&results.two_user_games[0]), atomic_load(&results.two_user_games[1])};
+    long t_user_games = two_user_games[0] + two_user_games[1];
+
+    seconds = (seconds > 0) ? seconds : 1e-9;
+
+    printf("| TOTAL GAMES      : %ld\n", t_user_games);
+    printf("| Two Player games : %ld  | Player 1 wins : %ld   | %%%2.2f\n", t_user_games, two_user_games[0],
+           t_user_games ? (two_user_games[0] * 100.0) / t_user_games : 0);
+    printf("|                         | Player 2 wins : %ld   | %%%2.2f\n", two_user_games[1],
+           t_user_games ? (two_user_games[1] * 100.0) / t_user_games : 0);
+
+    printf("\nmoves             : %ld\n", atomic_load(&results.moves));
+    printf("time              : %.3f s\n", seconds);
+    printf("games/sec         : %.0f\n", t_user_games / seconds);
+
+    // Engine games of every config -> vs Computer rows of the stats screen
+    printf("\n%-32s %12s %12s %12s %8s %9s\n", "config", "vs Computer", "Wins", "Loses", "score", "elo");
+    for (int i = 0; i < no_configs; i++)
+    {
+        long engine_games[2] = {atomic_load(&results.engine_games[i][0]), atomic_load(&results.engine_games[i][1])};
+        long t_engine_games = engine_games[0] + engine_games[1];
+
+        printf("%-32s %12ld %12ld %12ld %7.2f%% %+9.1f\n", configs[i].name, t_engine_games, engine_games[0], engine_games[1],
+               t_engine_games ? (engine_games[0] * 100.0) / t_engine_games : 0, elo[i]);
+    }
+
+    printf("\n");
+    for (int i = 0; i < no_configs; i++)
+    {
+        for (int j = i + 1; j < no_configs; j++)
+        {
+            printf("%s vs %s : %ld - %ld\n", configs[i].name, configs[j].name,
+                   atomic_load(&results.pair_wins[i][j]), atomic_load(&results.pair_wins[j][i]));
+        }
+    }
+}
@@ -0,0 +1,263 @@
+/* Engine worker thread -> moves are requested & collected without blocking the UI
+ * Idle time during the human's turn is used to ponder replies to every human move */
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include "engine.h"
+#include "position.h"
+#include "worker.h"
+
+/* FUNCTIONS */
+int start_worker(worker *w, engine *eng);
+void stop_worker(worker *w);
+
+void request_move(worker *w, position pos);
+int wait_move(worker *w, int *move, int timeout_ms);
+void cancel_move(worker *w);
+
+void start_ponder(worker *w, position pos);
+
+void *run_worker(void *arg);
+void think(worker *w);
+void ponder(worker *w);
+
+// Start worker thread using an engine
+// Returns 1: started, 0: otherwise
+int start_worker(worker *w, engine *eng)
+{
+    w -> eng = eng;
+    w -> pos = 0;
+    w -> request = 0;
+    w -> pending = w -> ready = w -> stopping = 0;
+    w -> move = -1;
+
+    w -> ponder_pos = 0;
+    w -> ponder_pending = 0;
+    w -> no_replies = 0;
+
+    pthread_mutex_init(&w -> lock, NULL);
+    pthread_cond_init(&w -> changed, NULL);
+
+    if (pthread_create(&w -> thread, NULL, run_worker, w))
+    {
+        pthread_cond_destroy(&w -> changed);
+        pthread_mutex_destroy(&w -> lock);
+        return 0;
+    }
+
+    return 1;
+}
+
+// Stop worker thread -> waits for a move being chosen to finish
+void stop_worker(worker *w)
+{
+    pthread_mutex_lock(&w -> lock);
+    w -> stopping = 1;
+    w -> request++;
+    pthread_cond_broadcast(&w -> changed);
+    pthread_mutex_unlock(&w -> lock);
+
+    pthread_join(w -> thread, NULL);
+
+    pthread_cond_destroy(&w -> changed);
+    pthread_mutex_destroy(&w -> lock);
+}
+
+// Ask worker to choose a move in a position -> replaces any earlier request
+// A pondered reply is ready at once & leaves engine as if it chose the move itself
+void request_move(worker *w, position pos)
+{
+    pthread_mutex_lock(&w -> lock);
+    w -> request++;
+    w -> ponder_pending = 0;
+    w -> ready = 0;
+
+    for (int i = 0; i < w -> no_replies; i++)
+    {
+        if (w -> replies[i].pos == pos)
+        {
+            memcpy(w -> eng -> random_state, w -> replies[i].random_state, sizeof(w -> eng -> random_state));
+            w -> move = w -> replies[i].move;
+            w -> ready = 1;
+            break;
+        }
+    }
+
+    w -> no_replies = 0;
+
+    if (!w -> ready)
+    {
+        w -> pos = pos;
+        w -> pending = 1;
+    }
+
+    pthread_cond_broadcast(&w -> changed);
+    pthread_mutex_unlock(&w -> lock);
+}
+
+// Wait for move of the latest request
+// timeout_ms -> longest time to wait, 0: only check
+// Returns 1: move ready (stored in move), 0: still thinking
+int wait_move(worker *w, int *move, int timeout_ms)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&w -> lock);
+    while (!w -> ready && timeout_ms > 0)
+    {
+        if (pthread_cond_timedwait(&w -> changed, &w -> lock, &deadline) == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+
+    int ready = w -> ready;
+    if (ready)
+    {
+        *move = w -> move;
+        w -> ready = 0;
+    }
+    pthread_mutex_unlock(&w -> lock);
+
+    return ready;
+}
+
+// Drop latest request -> a move being chosen is thrown away when done
+void cancel_move(worker *w)
+{
+    pthread_mutex_lock(&w -> lock);
+    w -> request++;
+    w -> pending = 0;
+    w -> ready = 0;
+    w -> ponder_pending = 0;
+    w -> no_replies = 0;
+    pthread_mutex_unlock(&w -> lock);
+}
+
+// Ponder replies to every move the human can play in a position
+// Replaces any earlier request, replies are used by the next request_move
+void start_ponder(worker *w, position pos)
+{
+    pthread_mutex_lock(&w -> lock);
+    w -> request++;
+    w -> pending = 0;
+    w -> ready = 0;
+    w -> ponder_pos = pos;
+    w -> ponder_pending = 1;
+    w -> no_replies = 0;
+    pthread_cond_broadcast(&w -> changed);
+    pthread_mutex_unlock(&w -> lock);
+}
+
+// Worker thread -> choose moves & ponder until stopped
+void *run_worker(void *arg)
+{
+    worker *w = (worker *) arg;
+
+    pthread_mutex_lock(&w -> lock);
+    while (1)
+    {
+        while (!w -> pending && !w -> ponder_pending && !w -> stopping)
+        {
+            pthread_cond_wait(&w -> changed, &w -> lock);
+        }
+
+        if (w -> stopping)
+        {
+            break;
+        }
+
+        if (w -> pending)
+        {
+            think(w);
+        }
+        else
+        {
+            ponder(w);
+        }
+    }
+    pthread_mutex_unlock(&w -> lock);
+
+    return NULL;
+}
+
+// Choose move of the latest request -> called & returns holding lock
+// Engine runs on a copy without holding the lock, copy is kept only if not cancelled meanwhile
+void think(worker *w)
+{
+    position pos = w -> pos;
+    unsigned int request = w -> request;
+    engine eng = *(w -> eng);
+
+    w -> pending = 0;
+
+    pthread_mutex_unlock(&w -> lock);
+    int move = choose_move(&eng, pos);
+    pthread_mutex_lock(&w -> lock);
+
+    if (request == w -> request)
+    {
+        memcpy(w -> eng -> random_state, eng.random_state, sizeof(eng.random_state));
+        w -> move = move;
+        w -> ready = 1;
+        pthread_cond_broadcast(&w -> changed);
+    }
+}
+
+// Choose a reply to every human move -> called & returns holding lock
+// Every reply starts from the same engine state, so a game plays the same with or without pondering
+// Stops as soon as a move is requested or pondering is cancelled
+void ponder(worker *w)
+{
+    position pos = w -> ponder_pos;
+    unsigned int request = w -> request;
+    engine base = *(w -> eng);
+
+    w -> ponder_pending = 0;
+
+    for (int i = 0; i < NO_BOARDS; i++)
+    {
+        int board = GET_BOARD(pos, i);
+
+        if (is_dead(board))
+        {
+            continue;
+        }
+
+        for (int j = 0; j < BOARD_BITS; j++)
+        {
+            if (board & (1 << j))
+            {
+                continue;
+            }
+
+            position child = pos | MOVE_BIT(i * BOARD_BITS + j);
+            engine eng = base;
+
+            pthread_mutex_unlock(&w -> lock);
+            int move = choose_move(&eng, child);
+            pthread_mutex_lock(&w -> lock);
+
+            if (request != w -> request)
+            {
+                return;
+            }
+
+            pondered *reply = &w -> replies[w -> no_replies++];
+            reply -> pos = child;
+            reply -> move = move;
+            memcpy(reply -> random_state, eng.random_state, sizeof(eng.random_state));
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef WORKER_H_INCLUDED
+#define WORKER_H_INCLUDED
+
+#include <pthread.h>
+
+#include "engine.h"
+#include "position.h"
+
+/* Pondered reply -> engine's move after a human move & its random state after choosing it */
+typedef struct pondered
+{
+    position pos;                       // Position after the human move
+    int move;
+    uint64_t random_state[4];
+}pondered;
+
+/* Engine worker -> chooses moves on its own thread so the UI keeps running */
+typedef struct worker
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;             // Signalled on a new request, a finished move & stop
+
+    engine *eng;                        // Only read & written while holding lock
+
+    position pos;                       // Position of the latest request
+    unsigned int request;               // Id of the latest request -> older results are dropped
+    int pending;                        // 1: request not started yet
+    int ready;                          // 1: move of the latest request is ready
+    int move;
+    int stopping;
+
+    // Pondering -> replies to every human move, chosen while the human thinks
+    position ponder_pos;
+    int ponder_pending;                 // 1: pondering not started yet
+    pondered replies[NO_MOVES];
+    int no_replies;
+}worker;
+
+/* FUNCTIONS */
+int start_worker(worker *w, engine *eng);
+void stop_worker(worker *w);
+
+void request_move(worker *w, position pos);
+int wait_move(worker *w, int *move, int timeout_ms);
+void cancel_move(worker *w);
+
+void start_ponder(worker *w, position pos);
+
+#endif